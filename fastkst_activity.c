@@ -0,0 +1,577 @@
+/**
+ * @file fastkst_activity.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Rolling per-KST-day user activity bitmaps ("once per day" checks, DAU)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - slots[(day mod ndays) * nchunks + (user >> 16)] points to the container
+ *    of that day and user range. A container's day is set before it is
+ *    published with a CAS and never changes, so a writer that finds an
+ *    older day installs a fresh container and pushes the old one on the
+ *    retired list; a writer that finds a newer day has a late event.
+ *  - Retired containers are freed one expire call later: a thread still
+ *    holding the old pointer only touches memory of a day that is gone.
+ *  - expire also keeps the high-water day "today". Writes outside
+ *    (today - ndays, today + 1] are rejected, so a skewed timestamp can
+ *    neither occupy a slot with a future day nor revive an expired day.
+ *  - Test code: enabled with TEST_FASTKST_ACTIVITY
+ */
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "fastkst_activity.h"
+#include "fastkst_internal.h"
+
+#define CACHELINE       64
+#define CHUNK_SHIFT     16
+#define CHUNK_WORDS     ((1U << CHUNK_SHIFT) / 64)
+#define MAX_DAYS        366
+#define MAX_USERS       (1ULL << 32)
+#define NO_DAY          INT64_MIN
+
+typedef struct chunk {
+  _Atomic uint64_t bits[CHUNK_WORDS];
+  int64_t day;
+  struct chunk *next;             /* retired list link */
+} chunk_t;
+
+/* aligned_alloc() wants a multiple of the alignment */
+#define CHUNK_BYTES     ((sizeof(chunk_t) + CACHELINE - 1) & ~(size_t)(CACHELINE - 1))
+
+struct fastkst_activity {
+  uint64_t max_users;
+  unsigned ndays;
+  size_t nchunks;                 /* containers per day */
+  _Atomic(chunk_t *) *slots;      /* ndays * nchunks */
+  _Atomic(chunk_t *) retired;     /* pushed by writers and expire */
+  chunk_t *pending;               /* retired list taken by the last expire */
+  _Atomic int64_t today;          /* latest day seen by expire, NO_DAY before */
+};
+
+int64_t fastkst_activity_day(time_t t)
+{
+  return fastkst_floor_div((int64_t)t + KST_OFFSET, SECS_PER_DAY);
+}
+
+static inline _Atomic(chunk_t *) *slot_of(const fastkst_activity_t *a, int64_t day,
+                                          uint64_t user)
+{
+  int64_t r = day % (int64_t)a->ndays;
+  size_t s = (size_t)(r < 0 ? r + a->ndays : r);
+  return &a->slots[s * a->nchunks + (size_t)(user >> CHUNK_SHIFT)];
+}
+
+static void retire(fastkst_activity_t *a, chunk_t *c)
+{
+  chunk_t *head = atomic_load_explicit(&a->retired, memory_order_relaxed);
+
+  do {
+    c->next = head;
+  } while (!atomic_compare_exchange_weak_explicit(&a->retired, &head, c,
+                                                  memory_order_release,
+                                                  memory_order_relaxed));
+}
+
+static size_t free_list(chunk_t *c)
+{
+  size_t n = 0;
+
+  while (c != NULL) {
+    chunk_t *next = c->next;
+    free(c);
+    c = next;
+    n++;
+  }
+  return n;
+}
+
+fastkst_activity_t *fastkst_activity_create(uint64_t max_users, unsigned ndays)
+{
+  fastkst_activity_t *a;
+  size_t bytes;
+
+  if (max_users == 0 || max_users > MAX_USERS || ndays == 0 || ndays > MAX_DAYS) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  a = malloc(sizeof(*a));
+  if (a == NULL)
+    return NULL;
+
+  a->max_users = max_users;
+  a->ndays = ndays;
+  a->nchunks = (size_t)((max_users + (1U << CHUNK_SHIFT) - 1) >> CHUNK_SHIFT);
+  bytes = a->nchunks * ndays * sizeof(*a->slots);
+  a->slots = malloc(bytes);
+  if (a->slots == NULL) {
+    free(a);
+    return NULL;
+  }
+  memset((void *)a->slots, 0, bytes);
+  atomic_init(&a->retired, NULL);
+  atomic_init(&a->today, NO_DAY);
+  a->pending = NULL;
+  return a;
+}
+
+void fastkst_activity_destroy(fastkst_activity_t *a)
+{
+  size_t i;
+
+  if (a == NULL)
+    return;
+  for (i = 0; i < a->nchunks * a->ndays; i++)
+    free(atomic_load_explicit(&a->slots[i], memory_order_relaxed));
+  free_list(atomic_load_explicit(&a->retired, memory_order_relaxed));
+  free_list(a->pending);
+  free((void *)a->slots);
+  free(a);
+}
+
+/* Container of day for user, installing a fresh one over an older day */
+static chunk_t *chunk_for_write(fastkst_activity_t *a, int64_t day, uint64_t user)
+{
+  _Atomic(chunk_t *) *sp = slot_of(a, day, user);
+  chunk_t *c = atomic_load_explicit(sp, memory_order_acquire);
+  chunk_t *fresh;
+
+  if (c != NULL && c->day == day)
+    return c;
+
+  fresh = NULL;
+  for (;;) {
+    if (c != NULL && c->day > day) {
+      errno = ERANGE;                             /* day already replaced */
+      break;
+    }
+    if (fresh == NULL) {
+      fresh = aligned_alloc(CACHELINE, CHUNK_BYTES);
+      if (fresh == NULL)
+        return NULL;
+      memset((void *)fresh->bits, 0, sizeof(fresh->bits));
+      fresh->day = day;
+      fresh->next = NULL;
+    }
+    if (atomic_compare_exchange_strong_explicit(sp, &c, fresh, memory_order_acq_rel,
+                                                memory_order_acquire)) {
+      if (c != NULL)
+        retire(a, c);
+      return fresh;
+    }
+    if (c != NULL && c->day == day)               /* another writer won */
+      break;
+  }
+  free(fresh);
+  return c != NULL && c->day == day ? c : NULL;
+}
+
+static inline int test_and_set(fastkst_activity_t *a, int64_t day, uint64_t user)
+{
+  chunk_t *c;
+  _Atomic uint64_t *w;
+  uint64_t bit, old;
+
+  int64_t today = atomic_load_explicit(&a->today, memory_order_relaxed);
+
+  if (user >= a->max_users ||
+      (today != NO_DAY && (day > today + 1 || day <= today - (int64_t)a->ndays))) {
+    errno = ERANGE;
+    return -1;
+  }
+  c = chunk_for_write(a, day, user);
+  if (c == NULL)
+    return -1;
+
+  w = &c->bits[(user >> 6) & (CHUNK_WORDS - 1)];
+  bit = 1ULL << (user & 63);
+  /* repeat visits are the common case: skip the RMW and its cache line bounce */
+  if (atomic_load_explicit(w, memory_order_relaxed) & bit)
+    return 0;
+  old = atomic_fetch_or_explicit(w, bit, memory_order_relaxed);
+  return (old & bit) == 0;
+}
+
+static inline int test_bit(const fastkst_activity_t *a, int64_t day, uint64_t user)
+{
+  const chunk_t *c;
+
+  if (user >= a->max_users) {
+    errno = ERANGE;
+    return -1;
+  }
+  c = atomic_load_explicit(slot_of(a, day, user), memory_order_acquire);
+  if (c == NULL || c->day != day)
+    return 0;
+  return (atomic_load_explicit(&c->bits[(user >> 6) & (CHUNK_WORDS - 1)],
+                               memory_order_relaxed) >> (user & 63)) & 1;
+}
+
+int fastkst_activity_test_and_set(fastkst_activity_t *a, time_t t, uint64_t user)
+{
+  return test_and_set(a, fastkst_activity_day(t), user);
+}
+
+int fastkst_activity_test(const fastkst_activity_t *a, time_t t, uint64_t user)
+{
+  return test_bit(a, fastkst_activity_day(t), user);
+}
+
+size_t fastkst_activity_test_and_set_batch(fastkst_activity_t *a, const time_t *t,
+                                           const uint64_t *users, size_t n,
+                                           uint8_t *first)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    int r = test_and_set(a, fastkst_activity_day(t[i]), users[i]);
+    if (r < 0)
+      break;
+    if (first != NULL)
+      first[i] = (uint8_t)r;
+  }
+  return i;
+}
+
+size_t fastkst_activity_test_batch(const fastkst_activity_t *a, const time_t *t,
+                                   const uint64_t *users, size_t n, uint8_t *marked)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    int r = test_bit(a, fastkst_activity_day(t[i]), users[i]);
+    if (r < 0)
+      break;
+    marked[i] = (uint8_t)r;
+  }
+  return i;
+}
+
+static uint64_t day_count(const fastkst_activity_t *a, int64_t day)
+{
+  uint64_t sum = 0;
+  size_t k, w;
+
+  for (k = 0; k < a->nchunks; k++) {
+    const chunk_t *c = atomic_load_explicit(slot_of(a, day, (uint64_t)k << CHUNK_SHIFT),
+                                            memory_order_acquire);
+    if (c == NULL || c->day != day)
+      continue;
+    for (w = 0; w < CHUNK_WORDS; w++)
+      sum += (uint64_t)__builtin_popcountll(
+          atomic_load_explicit(&c->bits[w], memory_order_relaxed));
+  }
+  return sum;
+}
+
+uint64_t fastkst_activity_count(const fastkst_activity_t *a, time_t t)
+{
+  return day_count(a, fastkst_activity_day(t));
+}
+
+size_t fastkst_activity_history(const fastkst_activity_t *a, time_t now,
+                                uint64_t *out, size_t n)
+{
+  int64_t day = fastkst_activity_day(now);
+  size_t i;
+
+  if (n > a->ndays)
+    n = a->ndays;
+  for (i = 0; i < n; i++)
+    out[i] = day_count(a, day - (int64_t)i);
+  return n;
+}
+
+uint64_t fastkst_activity_distinct(const fastkst_activity_t *a, time_t now,
+                                   unsigned ndays)
+{
+  const chunk_t *cs[MAX_DAYS];
+  int64_t day = fastkst_activity_day(now);
+  uint64_t sum = 0;
+  size_t k, w;
+  unsigned i, nc;
+
+  if (ndays > a->ndays)
+    ndays = a->ndays;
+  for (k = 0; k < a->nchunks; k++) {
+    nc = 0;
+    for (i = 0; i < ndays; i++) {
+      const chunk_t *c = atomic_load_explicit(
+          slot_of(a, day - i, (uint64_t)k << CHUNK_SHIFT), memory_order_acquire);
+      if (c != NULL && c->day == day - i)
+        cs[nc++] = c;
+    }
+    if (nc == 0)
+      continue;
+    for (w = 0; w < CHUNK_WORDS; w++) {
+      uint64_t v = 0;
+      for (i = 0; i < nc; i++)
+        v |= atomic_load_explicit(&cs[i]->bits[w], memory_order_relaxed);
+      sum += (uint64_t)__builtin_popcountll(v);
+    }
+  }
+  return sum;
+}
+
+size_t fastkst_activity_expire(fastkst_activity_t *a, time_t now)
+{
+  int64_t today = atomic_load_explicit(&a->today, memory_order_relaxed);
+  int64_t day = fastkst_activity_day(now);
+  int64_t cutoff;
+  size_t freed = free_list(a->pending);
+  size_t i;
+
+  if (today == NO_DAY || day > today)
+    atomic_store_explicit(&a->today, today = day, memory_order_relaxed);
+  cutoff = today - (int64_t)a->ndays;
+
+  for (i = 0; i < a->nchunks * a->ndays; i++) {
+    chunk_t *c = atomic_load_explicit(&a->slots[i], memory_order_acquire);
+    if (c != NULL && (c->day <= cutoff || c->day > today + 1) &&
+        atomic_compare_exchange_strong_explicit(&a->slots[i], &c, NULL,
+                                                memory_order_acq_rel,
+                                                memory_order_relaxed))
+      retire(a, c);
+  }
+  a->pending = atomic_exchange_explicit(&a->retired, NULL, memory_order_acquire);
+  return freed;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_ACTIVITY
+/* 빌드 방법
+gcc -DTEST_FASTKST_ACTIVITY -o fastkst_activity_test fastkst_activity.c fastkst_localtime.c -lpthread
+./fastkst_activity_test
+*/
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#define NTHREADS        4
+#define THREAD_USERS    200000
+#define BENCH_OPS       2000000
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static const time_t base = 1767193200;          /* 2026-01-01 00:00:00 KST */
+static fastkst_activity_t *shared;
+static _Atomic uint64_t firsts;
+
+static void *race_thread(void *arg)
+{
+  uint64_t u, mine = 0;
+  (void)arg;
+  for (u = 0; u < THREAD_USERS; u++)
+    mine += fastkst_activity_test_and_set(shared, base + 3600, u * 7) == 1;
+  atomic_fetch_add(&firsts, mine);
+  return NULL;
+}
+
+/* Baseline: localtime_r + "YYYYMMDD:user" key + locked open-addressing set */
+#define BASE_SLOTS (1U << 22)
+static char (*base_keys)[32];
+static pthread_mutex_t base_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int baseline_test_and_set(time_t t, uint64_t user)
+{
+  struct tm tm;
+  char key[32];
+  uint32_t h = 2166136261U;
+  size_t i, len;
+  int r = 0;
+
+  localtime_r(&t, &tm);
+  len = strftime(key, sizeof(key), "%Y%m%d", &tm);
+  len += (size_t)snprintf(key + len, sizeof(key) - len, ":%llu", (unsigned long long)user);
+  for (i = 0; i < len; i++)
+    h = (h ^ (uint8_t)key[i]) * 16777619U;
+  pthread_mutex_lock(&base_lock);
+  for (i = h & (BASE_SLOTS - 1);; i = (i + 1) & (BASE_SLOTS - 1)) {
+    if (base_keys[i][0] == '\0') {
+      memcpy(base_keys[i], key, len + 1);
+      r = 1;
+      break;
+    }
+    if (strcmp(base_keys[i], key) == 0)
+      break;
+  }
+  pthread_mutex_unlock(&base_lock);
+  return r;
+}
+
+static double get_time_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec * 1000000.0 + (double)tv.tv_usec;
+}
+
+int main(void)
+{
+  fastkst_activity_t *a;
+  uint64_t hist[4], u;
+  time_t ts[1000];
+  uint64_t users[1000];
+  uint8_t first[1000], marked[1000];
+  pthread_t th[NTHREADS];
+  size_t i, freed;
+  int ok;
+
+  printf("=== FASTKST_ACTIVITY Test ===\n\n");
+
+  CHECK(fastkst_activity_create(0, 7) == NULL && errno == EINVAL &&
+        fastkst_activity_create(100, 0) == NULL && fastkst_activity_create(100, 367) == NULL,
+        "invalid arguments");
+
+  /* Days change at KST midnight, not UTC midnight */
+  a = fastkst_activity_create(1000000, 3);
+  CHECK(fastkst_activity_day(base) == 20454 && fastkst_activity_day(base - 1) == 20453,
+        "KST epoch day");
+  CHECK(fastkst_activity_test_and_set(a, base - 1, 42) == 1 &&
+        fastkst_activity_test_and_set(a, base, 42) == 1 &&
+        fastkst_activity_test_and_set(a, base + 14 * 3600, 42) == 0 &&
+        fastkst_activity_test_and_set(a, base + 86399, 42) == 0,
+        "once per KST day");
+  CHECK(fastkst_activity_test(a, base + 100, 42) == 1 && fastkst_activity_test(a, base, 43) == 0 &&
+        fastkst_activity_test(a, base + 86400, 42) == 0, "test");
+  errno = 0;
+  CHECK(fastkst_activity_test_and_set(a, base, 1000000) == -1 && errno == ERANGE &&
+        fastkst_activity_test(a, base, 1000000) == -1, "user out of range");
+
+  /* DAU, history and distinct users across days */
+  fastkst_activity_test_and_set(a, base - 1, 5);
+  fastkst_activity_test_and_set(a, base, 999999);     /* second container */
+  fastkst_activity_test_and_set(a, base + 86400, 42);
+  fastkst_activity_test_and_set(a, base + 86400, 7);
+  fastkst_activity_history(a, base + 86400, hist, 4);
+  CHECK(fastkst_activity_count(a, base) == 2 && hist[0] == 2 && hist[1] == 2 && hist[2] == 2,
+        "count and history");
+  CHECK(fastkst_activity_distinct(a, base + 86400, 2) == 3 &&
+        fastkst_activity_distinct(a, base + 86400, 30) == 4, "distinct users over days");
+
+  /* Rotation: day base + 3 takes the slot of day base */
+  CHECK(fastkst_activity_test_and_set(a, base + 3 * 86400, 42) == 1 &&
+        fastkst_activity_test(a, base, 42) == 0 && fastkst_activity_count(a, base) == 1,
+        "newer day replaces the oldest slot");
+  errno = 0;
+  CHECK(fastkst_activity_test_and_set(a, base + 10, 42) == -1 && errno == ERANGE,
+        "late event rejected");
+
+  /* Expiry: two calls free everything once all days are out of the window */
+  freed = fastkst_activity_expire(a, base + 30 * 86400);
+  freed += fastkst_activity_expire(a, base + 30 * 86400);
+  CHECK(freed == 5 && fastkst_activity_count(a, base + 3 * 86400) == 0, "expire frees containers");
+  fastkst_activity_destroy(a);
+
+  /* A skewed future timestamp cannot block a slot, an expired day cannot come back */
+  a = fastkst_activity_create(100000, 3);
+  CHECK(fastkst_activity_test_and_set(a, base + 7000 * 86400L, 1) == 1 &&
+        fastkst_activity_expire(a, base) == 0 &&
+        fastkst_activity_test_and_set(a, base + 3600, 1) == 1,
+        "expire retires a future day installed before it ran");
+  errno = 0;
+  ok = fastkst_activity_test_and_set(a, base + 7000 * 86400L, 2) == -1 && errno == ERANGE;
+  errno = 0;
+  ok &= fastkst_activity_test_and_set(a, base + 2 * 86400, 2) == -1 && errno == ERANGE;
+  ok &= fastkst_activity_test_and_set(a, base + 86400 + 10, 2) == 1;
+  ok &= fastkst_activity_test_and_set(a, base + 3600, 1) == 0;
+  CHECK(ok, "days after today + 1 rejected");
+  fastkst_activity_test_and_set(a, base - 86400, 3);
+  fastkst_activity_expire(a, base + 2 * 86400);
+  errno = 0;
+  ok = fastkst_activity_test_and_set(a, base - 86400, 3) == -1 && errno == ERANGE;
+  errno = 0;
+  ok &= fastkst_activity_test_and_set(a, base - 1000 * 86400L, 3) == -1 && errno == ERANGE;
+  ok &= fastkst_activity_test_and_set(a, base, 3) == 1;
+  CHECK(ok, "days at or before the cutoff rejected after expire");
+  fastkst_activity_expire(a, base);                   /* clock stepped back */
+  CHECK(fastkst_activity_test_and_set(a, base + 3 * 86400, 4) == 1,
+        "today is a high-water mark");
+  fastkst_activity_destroy(a);
+
+  /* Batch matches single calls */
+  a = fastkst_activity_create(5000, 7);
+  {
+    fastkst_activity_t *b = fastkst_activity_create(5000, 7);
+    srand(90);
+    for (i = 0; i < 1000; i++) {
+      ts[i] = base + rand() % (3 * 86400);
+      users[i] = (uint64_t)(rand() % 300);
+    }
+    ok = fastkst_activity_test_and_set_batch(a, ts, users, 1000, first) == 1000;
+    for (i = 0; i < 1000; i++)
+      ok &= fastkst_activity_test_and_set(b, ts[i], users[i]) == first[i];
+    ok &= fastkst_activity_test_batch(a, ts, users, 1000, marked) == 1000;
+    for (i = 0; i < 1000; i++)
+      ok &= marked[i] == 1;
+    users[500] = 5000;
+    ok &= fastkst_activity_test_and_set_batch(a, ts, users, 1000, NULL) == 500;
+    CHECK(ok, "batch test-and-set / test");
+    fastkst_activity_destroy(b);
+  }
+  fastkst_activity_destroy(a);
+
+  /* Racing threads: exactly one first per user */
+  shared = fastkst_activity_create(THREAD_USERS * 7, 7);
+  for (i = 0; i < NTHREADS; i++)
+    pthread_create(&th[i], NULL, race_thread, NULL);
+  for (i = 0; i < NTHREADS; i++)
+    pthread_join(th[i], NULL);
+  CHECK(atomic_load(&firsts) == THREAD_USERS && fastkst_activity_count(shared, base) == THREAD_USERS,
+        "one winner per user across threads");
+  fastkst_activity_destroy(shared);
+
+  /* Benchmark */
+  printf("\n=== Performance Benchmark ===\n\n");
+  {
+    double t0, fast_ns, base_ns;
+    uint64_t hits = 0, base_hits = 0;
+
+    a = fastkst_activity_create(1 << 20, 7);
+    t0 = get_time_usec();
+    for (u = 0; u < BENCH_OPS; u++)
+      hits += fastkst_activity_test_and_set(a, base + (time_t)(u & 65535), (u * 2654435761U) & 0xFFFFF) == 1;
+    fast_ns = (get_time_usec() - t0) * 1000.0 / BENCH_OPS;
+    fastkst_activity_destroy(a);
+
+    setenv("TZ", "KST-9", 1);
+    tzset();
+    base_keys = calloc(BASE_SLOTS, sizeof(*base_keys));
+    t0 = get_time_usec();
+    for (u = 0; u < BENCH_OPS; u++)
+      base_hits += baseline_test_and_set(base + (time_t)(u & 65535), (u * 2654435761U) & 0xFFFFF);
+    base_ns = (get_time_usec() - t0) * 1000.0 / BENCH_OPS;
+    free(base_keys);
+
+    printf("fastkst_activity_test_and_set(): %7.2f ns/op   localtime_r+hash set: %7.2f ns/op\n",
+           fast_ns, base_ns);
+    CHECK(hits == base_hits, "same answers as the baseline");
+  }
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All activity tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d activity test(s) failed!\n", failures);
+  return 1;
+}
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file fastkst_activity.h
+ * @brief Rolling per-KST-day user activity bitmaps ("once per day" checks, DAU)
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Answers "has user U done X on this KST day?" for daily rewards and
+ *    caps. The day is the KST epoch day, floor((t + 9h) / 86400): no
+ *    struct tm, no localtime_r(), no date-string keys.
+ *  - Keeps the last ndays days. Each day is split into containers of
+ *    65536 user IDs (8 KB dense bitsets, as in Roaring bitmap containers)
+ *    that are allocated on first use, so sparse ID spaces stay small.
+ *  - Test-and-set is one atomic fetch-or; there are no locks on any path.
+ *  - A container left over from an older day is replaced when a newer day
+ *    reaches its slot. Replaced containers are freed by
+ *    fastkst_activity_expire(), which must be called periodically.
+ */
+
+#ifndef FASTKST_ACTIVITY_H
+#define FASTKST_ACTIVITY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct fastkst_activity fastkst_activity_t;
+
+/**
+ * @brief KST epoch day of t (1970-01-01 KST = 0)
+ */
+int64_t fastkst_activity_day(time_t t);
+
+/**
+ * @brief Create an activity table
+ * @param[in] max_users user IDs are 0..max_users-1, 1..2^32
+ * @param[in] ndays days of history kept, 1..366
+ * @return fastkst_activity_t* table, NULL on failure (errno set)
+ */
+fastkst_activity_t *fastkst_activity_create(uint64_t max_users, unsigned ndays);
+
+/**
+ * @brief Destroy a table
+ */
+void fastkst_activity_destroy(fastkst_activity_t *a);
+
+/**
+ * @brief Mark user active on the KST day containing t
+ * @param[in] a table
+ * @param[in] t time of the event
+ * @param[in] user user ID
+ * @return int 1 if this is the user's first event of that day, 0 if the
+ *         user was already marked, -1 on failure: errno ERANGE when user is
+ *         out of range, the day has been replaced by a newer one (late
+ *         event) or the day is outside (today - ndays, today + 1] for the
+ *         today kept by fastkst_activity_expire(); ENOMEM when a container
+ *         cannot be allocated
+ *
+ * @note Until the first fastkst_activity_expire() call there is no today
+ *       and only the slot check applies; call it once right after create.
+ */
+int fastkst_activity_test_and_set(fastkst_activity_t *a, time_t t, uint64_t user);
+
+/**
+ * @brief Check whether user is marked on the KST day containing t
+ * @return int 1 marked, 0 not marked (including days no longer kept),
+ *         -1 when user is out of range (errno ERANGE)
+ */
+int fastkst_activity_test(const fastkst_activity_t *a, time_t t, uint64_t user);
+
+/**
+ * @brief Batch version of fastkst_activity_test_and_set()
+ * @param[in] a table
+ * @param[in] t event times
+ * @param[in] users user IDs
+ * @param[in] n number of events
+ * @param[out] first first[i] = 1 if event i was the user's first of its day
+ *             (optional, can be NULL)
+ * @return size_t number of events processed; stops at the first failure
+ *         (errno set as in fastkst_activity_test_and_set())
+ */
+size_t fastkst_activity_test_and_set_batch(fastkst_activity_t *a, const time_t *t,
+                                           const uint64_t *users, size_t n,
+                                           uint8_t *first);
+
+/**
+ * @brief Batch version of fastkst_activity_test()
+ * @param[out] marked marked[i] = 1 if user i is marked
+ * @return size_t number of events processed; stops at the first user out of
+ *         range (errno ERANGE)
+ */
+size_t fastkst_activity_test_batch(const fastkst_activity_t *a, const time_t *t,
+                                   const uint64_t *users, size_t n, uint8_t *marked);
+
+/**
+ * @brief Number of distinct users marked on the KST day containing t (DAU)
+ * @return uint64_t popcount of the day, 0 if the day is not kept
+ */
+uint64_t fastkst_activity_count(const fastkst_activity_t *a, time_t t);
+
+/**
+ * @brief Per-day counts ending at the KST day containing now
+ * @param[out] out out[0] = today, out[k] = k days earlier
+ * @param[in] n entries wanted (clamped to ndays)
+ * @return size_t number of entries written
+ */
+size_t fastkst_activity_history(const fastkst_activity_t *a, time_t now,
+                                uint64_t *out, size_t n);
+
+/**
+ * @brief Distinct users over the ndays KST days ending at the day containing
+ *        now (e.g. 7 for WAU), counted once even if active on several days
+ * @return uint64_t number of users, ndays is clamped to the table's ndays
+ */
+uint64_t fastkst_activity_distinct(const fastkst_activity_t *a, time_t now,
+                                   unsigned ndays);
+
+/**
+ * @brief Drop days that fell out of the window and free replaced containers
+ * @param[in] a table
+ * @param[in] now current time. today becomes the KST day of now if that is
+ *            later than the current today (high-water mark); days at or
+ *            before today - ndays and days after today + 1 are dropped
+ * @return size_t number of containers freed
+ *
+ * @note Call from one thread at a time, periodically (e.g. every minute).
+ *       A container is freed on the call after the one that sees it
+ *       replaced, so no other call on the table may take longer than the
+ *       interval between two expire calls.
+ */
+size_t fastkst_activity_expire(fastkst_activity_t *a, time_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_ACTIVITY_H */
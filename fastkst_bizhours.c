@@ -0,0 +1,458 @@
+/**
+ * @file fastkst_bizhours.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Business (working) seconds between KST timestamps
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Every compiled day has a class: its tm_wday (0..6) or CLASS_HOLIDAY.
+ *    prefix[i] is the number of business seconds before compiled day i, so
+ *    the business time before an instant is prefix[day] plus the part of
+ *    that day's spans before its second of day.
+ *  - Test code: enabled with TEST_FASTKST_BIZHOURS
+ */
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include "fastkst_bizhours.h"
+#include "fastkst_internal.h"
+
+#define MAX_BIZ_YEARS   10000
+#define CLASS_HOLIDAY   7
+
+struct day_class {
+  int n;
+  int32_t start[FASTKST_BIZ_MAX_SPANS];
+  int32_t end[FASTKST_BIZ_MAX_SPANS];
+};
+
+struct fastkst_bizhours {
+  struct day_class cls[8];
+  int64_t first_day;        /* KST epoch day of compiled day 0 */
+  int64_t ndays;
+  uint8_t *day_class;       /* ndays classes */
+  int64_t *prefix;          /* ndays + 1 running totals */
+};
+
+/* Sort and merge the spans of one weekday */
+static int build_class(const fastkst_biz_span_t *span, int n, struct day_class *c)
+{
+  int i, j;
+
+  c->n = 0;
+  if (n < 0 || n > FASTKST_BIZ_MAX_SPANS)
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    int32_t s = span[i].start, e = span[i].end;
+
+    if (s < 0 || e < s || e > SECS_PER_DAY)
+      return 0;
+    if (s == e)
+      continue;
+    for (j = c->n; j > 0 && c->start[j - 1] > s; j--) {
+      c->start[j] = c->start[j - 1];
+      c->end[j] = c->end[j - 1];
+    }
+    c->start[j] = s;
+    c->end[j] = e;
+    c->n++;
+  }
+
+  for (i = 1, j = 0; i < c->n; i++) {
+    if (c->start[i] <= c->end[j]) {
+      if (c->end[i] > c->end[j])
+        c->end[j] = c->end[i];
+    } else {
+      j++;
+      c->start[j] = c->start[i];
+      c->end[j] = c->end[i];
+    }
+  }
+  if (c->n > 0)
+    c->n = j + 1;
+  return 1;
+}
+
+/* Business seconds of a day before its second sec (0..86400) */
+static inline int64_t before_in_day(const struct day_class *c, int64_t sec)
+{
+  int64_t acc = 0;
+  int k;
+
+  for (k = 0; k < c->n; k++) {
+    int64_t s = c->start[k], e = c->end[k];
+    acc += (sec < s ? s : sec > e ? e : sec) - s;
+  }
+  return acc;
+}
+
+static inline int64_t weekday_of(int64_t day)
+{
+  int64_t w = (day + 4) % 7;    /* January 1, 1970 was a Thursday. */
+  return w < 0 ? w + 7 : w;
+}
+
+fastkst_bizhours_t *fastkst_bizhours_compile(const fastkst_bizhours_def_t *def,
+                                             int first_year, int last_year)
+{
+  fastkst_bizhours_t *bh;
+  int64_t i;
+  size_t h;
+  int w;
+
+  if (def == NULL || (def->nholidays > 0 && def->holidays == NULL) ||
+      last_year < first_year || last_year - first_year >= MAX_BIZ_YEARS) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  bh = malloc(sizeof(*bh));
+  if (bh == NULL)
+    return NULL;
+
+  for (w = 0; w < 7; w++) {
+    if (!build_class(def->span[w], def->nspans[w], &bh->cls[w])) {
+      free(bh);
+      errno = EINVAL;
+      return NULL;
+    }
+  }
+  bh->cls[CLASS_HOLIDAY].n = 0;
+
+  bh->first_day = fastkst_days_from_civil(first_year, 1, 1);
+  bh->ndays = fastkst_days_from_civil((int64_t)last_year + 1, 1, 1) - bh->first_day;
+  bh->day_class = malloc((size_t)bh->ndays);
+  bh->prefix = malloc(((size_t)bh->ndays + 1) * sizeof(int64_t));
+  if (bh->day_class == NULL || bh->prefix == NULL) {
+    fastkst_bizhours_free(bh);
+    return NULL;
+  }
+
+  w = (int)weekday_of(bh->first_day);
+  for (i = 0; i < bh->ndays; i++) {
+    bh->day_class[i] = (uint8_t)w;
+    if (++w == 7)
+      w = 0;
+  }
+  for (h = 0; h < def->nholidays; h++) {
+    i = fastkst_floor_div((int64_t)def->holidays[h] + KST_OFFSET, SECS_PER_DAY) - bh->first_day;
+    if (i >= 0 && i < bh->ndays)
+      bh->day_class[i] = CLASS_HOLIDAY;
+  }
+
+  bh->prefix[0] = 0;
+  for (i = 0; i < bh->ndays; i++)
+    bh->prefix[i + 1] = bh->prefix[i] +
+                        before_in_day(&bh->cls[bh->day_class[i]], SECS_PER_DAY);
+  return bh;
+}
+
+void fastkst_bizhours_free(fastkst_bizhours_t *bh)
+{
+  if (bh == NULL)
+    return;
+  free(bh->day_class);
+  free(bh->prefix);
+  free(bh);
+}
+
+/* Business seconds from the start of the compiled range to t */
+static inline int elapsed(const fastkst_bizhours_t *bh, time_t t, int64_t *out)
+{
+  int64_t lt = (int64_t)t + KST_OFFSET;
+  int64_t day = fastkst_floor_div(lt, SECS_PER_DAY);
+  int64_t i = day - bh->first_day;
+
+  if (i < 0 || i >= bh->ndays) {
+    errno = ERANGE;
+    return 0;
+  }
+  *out = bh->prefix[i] +
+         before_in_day(&bh->cls[bh->day_class[i]], lt - day * SECS_PER_DAY);
+  return 1;
+}
+
+/* Earliest instant at which target business seconds have elapsed */
+static inline int locate(const fastkst_bizhours_t *bh, int64_t target, time_t *out)
+{
+  const struct day_class *c;
+  int64_t lo = 0, hi = bh->ndays - 1;
+  int k;
+
+  if (target < 0 || target > bh->prefix[bh->ndays]) {
+    errno = ERANGE;
+    return 0;
+  }
+  if (target == 0) {
+    *out = (time_t)(bh->first_day * SECS_PER_DAY - KST_OFFSET);
+    return 1;
+  }
+
+  /* first day whose running total reaches target */
+  while (lo < hi) {
+    int64_t mid = lo + (hi - lo) / 2;
+    if (bh->prefix[mid + 1] >= target)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+
+  target -= bh->prefix[lo];
+  c = &bh->cls[bh->day_class[lo]];
+  for (k = 0; k < c->n - 1 && target > c->end[k] - c->start[k]; k++)
+    target -= c->end[k] - c->start[k];
+
+  *out = (time_t)((bh->first_day + lo) * SECS_PER_DAY - KST_OFFSET + c->start[k] + target);
+  return 1;
+}
+
+int fastkst_business_seconds(const fastkst_bizhours_t *bh, time_t t1, time_t t2,
+                             int64_t *out)
+{
+  int64_t e1, e2;
+
+  if (bh == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (!elapsed(bh, t1, &e1) || !elapsed(bh, t2, &e2))
+    return 0;
+  *out = e2 - e1;
+  return 1;
+}
+
+int fastkst_add_business_seconds(const fastkst_bizhours_t *bh, time_t t,
+                                 int64_t secs, time_t *out)
+{
+  int64_t base;
+
+  if (bh == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (!elapsed(bh, t, &base))
+    return 0;
+  if (secs == 0) {
+    *out = t;
+    return 1;
+  }
+  if (secs > bh->prefix[bh->ndays] || secs < -bh->prefix[bh->ndays]) {
+    errno = ERANGE;
+    return 0;
+  }
+  return locate(bh, base + secs, out);
+}
+
+size_t fastkst_business_seconds_batch(const fastkst_bizhours_t *bh,
+                                      const time_t *t1, const time_t *t2,
+                                      size_t n, int64_t *out)
+{
+  size_t i;
+
+  if (bh == NULL || (n > 0 && (t1 == NULL || t2 == NULL || out == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    int64_t e1, e2;
+
+    if (!elapsed(bh, t1[i], &e1) || !elapsed(bh, t2[i], &e2))
+      return i;
+    out[i] = e2 - e1;
+  }
+  return n;
+}
+
+size_t fastkst_add_business_seconds_batch(const fastkst_bizhours_t *bh,
+                                          const time_t *t, const int64_t *secs,
+                                          size_t n, time_t *out)
+{
+  size_t i;
+
+  if (bh == NULL || (n > 0 && (t == NULL || secs == NULL || out == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (!fastkst_add_business_seconds(bh, t[i], secs[i], &out[i]))
+      return i;
+  }
+  return n;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_BIZHOURS
+/* 빌드 방법
+gcc -DTEST_FASTKST_BIZHOURS -o fastkst_bizhours_test fastkst_bizhours.c fastkst_localtime.c
+./fastkst_bizhours_test
+*/
+#include <stdio.h>
+#include <string.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static time_t kst(int y, int m, int d, int hh, int mm)
+{
+  return (time_t)(fastkst_days_from_civil(y, m, d) * SECS_PER_DAY +
+                  hh * SECS_PER_HOUR + mm * 60 - KST_OFFSET);
+}
+
+/* Reference: one second at a time through fastkst_localtime() */
+static int64_t slow_business_seconds(time_t t1, time_t t2, const time_t *hol, size_t nhol)
+{
+  int64_t acc = 0;
+  time_t t;
+
+  for (t = t1; t < t2; t++) {
+    struct tm tm;
+    int sec, open;
+    size_t h;
+
+    fastkst_localtime(t, &tm);
+    sec = tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    open = tm.tm_wday >= 1 && tm.tm_wday <= 5 &&
+           ((sec >= 9 * 3600 && sec < 12 * 3600) || (sec >= 13 * 3600 && sec < 18 * 3600));
+    for (h = 0; open && h < nhol; h++) {
+      if ((hol[h] + KST_OFFSET) / SECS_PER_DAY == ((int64_t)t + KST_OFFSET) / SECS_PER_DAY)
+        open = 0;
+    }
+    acc += open;
+  }
+  return acc;
+}
+
+int main(void)
+{
+  /* 2026-01-01, Seollal 2026-02-16..18 */
+  const time_t hol[4] = { kst(2026, 1, 1, 0, 0), kst(2026, 2, 16, 12, 0),
+                          kst(2026, 2, 17, 12, 0), kst(2026, 2, 18, 23, 59) };
+  fastkst_bizhours_def_t def;
+  fastkst_bizhours_t *bh;
+  int64_t secs;
+  time_t u;
+  int w;
+
+  printf("=== FASTKST_BIZHOURS Test ===\n\n");
+
+  /* Weekdays 09:00-12:00 and 13:00-18:00; spans given out of order and overlapping */
+  memset(&def, 0, sizeof(def));
+  for (w = 1; w <= 5; w++) {
+    def.span[w][0].start = 13 * 3600;
+    def.span[w][0].end = 18 * 3600;
+    def.span[w][1].start = 9 * 3600;
+    def.span[w][1].end = 11 * 3600;
+    def.span[w][2].start = 10 * 3600;
+    def.span[w][2].end = 12 * 3600;
+    def.nspans[w] = 3;
+  }
+  def.holidays = hol;
+  def.nholidays = 4;
+  bh = fastkst_bizhours_compile(&def, 2025, 2027);
+  CHECK(bh != NULL, "compile");
+
+  /* Wed 2025-12-31 17:00 -> Fri 2026-01-02 (Thursday is a holiday) */
+  CHECK(fastkst_business_seconds(bh, kst(2025, 12, 31, 17, 0), kst(2026, 1, 2, 10, 0), &secs) &&
+        secs == 2 * 3600, "span across a holiday");
+  CHECK(fastkst_business_seconds(bh, kst(2026, 1, 2, 10, 0), kst(2025, 12, 31, 17, 0), &secs) &&
+        secs == -2 * 3600, "reversed arguments give a negative value");
+  CHECK(fastkst_add_business_seconds(bh, kst(2025, 12, 31, 17, 0), 2 * 3600, &u) &&
+        u == kst(2026, 1, 2, 10, 0), "add across a holiday");
+  CHECK(fastkst_add_business_seconds(bh, kst(2025, 12, 31, 17, 0), 3600, &u) &&
+        u == kst(2025, 12, 31, 18, 0), "deadline at closing time stays on the same day");
+  CHECK(fastkst_add_business_seconds(bh, kst(2026, 1, 5, 11, 0), 2 * 3600, &u) &&
+        u == kst(2026, 1, 5, 14, 0), "lunch break skipped");
+  CHECK(fastkst_add_business_seconds(bh, kst(2026, 1, 5, 10, 0), -2 * 3600, &u) &&
+        u == kst(2026, 1, 2, 17, 0), "negative add goes back to the previous week");
+  CHECK(fastkst_add_business_seconds(bh, kst(2026, 1, 3, 3, 0), 0, &u) &&
+        u == kst(2026, 1, 3, 3, 0), "zero add keeps t");
+  CHECK(fastkst_business_seconds(bh, kst(2024, 12, 31, 0, 0), kst(2025, 1, 2, 0, 0), &secs) == 0 &&
+        errno == ERANGE, "out of range rejected");
+
+  /* Random pairs against the one-second reference */
+  {
+    int i, bad = 0;
+
+    srand(82);
+    for (i = 0; i < 60; i++) {
+      time_t a = kst(2026, 1, 20, 0, 0) + rand() % (60 * SECS_PER_DAY) - 30 * SECS_PER_DAY;
+      time_t b = a + rand() % (4 * SECS_PER_DAY);
+
+      if (!fastkst_business_seconds(bh, a, b, &secs) || secs != slow_business_seconds(a, b, hol, 4))
+        bad++;
+    }
+    CHECK(bad == 0, "business seconds match the per-second reference");
+  }
+
+  /* add is the earliest inverse */
+  {
+    enum { N = 20000 };
+    static time_t ts[N], out[N];
+    static int64_t add[N];
+    int i, bad = 0;
+
+    for (i = 0; i < N; i++) {
+      ts[i] = kst(2025, 3, 1, 0, 0) + (time_t)(rand() % (600 * SECS_PER_DAY));
+      add[i] = (int64_t)(rand() % (40 * 8 * 3600)) - 20 * 8 * 3600;
+    }
+    CHECK(fastkst_add_business_seconds_batch(bh, ts, add, N, out) == N, "add batch");
+    for (i = 0; i < N; i++) {
+      int64_t s1, s0;
+      if (add[i] == 0)
+        continue;
+      if (!fastkst_business_seconds(bh, ts[i], out[i], &s1) ||
+          !fastkst_business_seconds(bh, ts[i], out[i] - 1, &s0) ||
+          s1 != add[i] || s0 != add[i] - 1)
+        bad++;
+    }
+    CHECK(bad == 0, "add returns the earliest instant reaching the target");
+  }
+
+  /* Batch stops at the first out-of-range element */
+  {
+    time_t a[3] = { kst(2025, 1, 1, 0, 0), kst(2026, 6, 1, 0, 0), kst(2026, 6, 1, 0, 0) };
+    time_t b[3] = { kst(2025, 1, 8, 0, 0), kst(2026, 6, 2, 0, 0), kst(2028, 1, 1, 0, 0) };
+    int64_t o[3];
+
+    CHECK(fastkst_business_seconds_batch(bh, a, b, 3, o) == 2 &&
+          o[0] == 5 * 8 * 3600 && o[1] == 8 * 3600,
+          "seconds batch stops at the first out-of-range row");
+  }
+  fastkst_bizhours_free(bh);
+
+  /* Invalid spans */
+  memset(&def, 0, sizeof(def));
+  def.nspans[1] = 1;
+  def.span[1][0].start = 10 * 3600;
+  def.span[1][0].end = 9 * 3600;
+  CHECK(fastkst_bizhours_compile(&def, 2025, 2025) == NULL && errno == EINVAL,
+        "reversed span rejected");
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All bizhours tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d bizhours test(s) failed!\n", failures);
+  return 1;
+}
+#endif
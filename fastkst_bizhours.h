@@ -0,0 +1,111 @@
+/**
+ * @file fastkst_bizhours.h
+ * @brief Business (working) seconds between KST timestamps
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - A definition (up to FASTKST_BIZ_MAX_SPANS opening spans per weekday plus
+ *    a holiday list) is compiled once for a range of years into a per-day
+ *    prefix sum of business seconds.
+ *  - fastkst_business_seconds() is then two day/second splits, two table
+ *    reads and a walk over the day's spans; fastkst_add_business_seconds()
+ *    binary searches the same prefix sums.
+ */
+
+#ifndef FASTKST_BIZHOURS_H
+#define FASTKST_BIZHOURS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FASTKST_BIZ_MAX_SPANS   4
+
+/**
+ * @brief Opening span of a day, in seconds after 00:00 KST
+ */
+typedef struct {
+  int32_t start;              /**< 0..86400, inclusive */
+  int32_t end;                /**< start..86400, exclusive */
+} fastkst_biz_span_t;
+
+/**
+ * @brief Business hours definition
+ */
+typedef struct {
+  fastkst_biz_span_t span[7][FASTKST_BIZ_MAX_SPANS];  /**< by tm_wday (0 = Sunday) */
+  int nspans[7];              /**< 0..FASTKST_BIZ_MAX_SPANS, 0 = closed */
+  const time_t *holidays;     /**< any instant of each closed KST day (optional) */
+  size_t nholidays;
+} fastkst_bizhours_def_t;
+
+typedef struct fastkst_bizhours fastkst_bizhours_t;
+
+/**
+ * @brief Compile a definition for a range of years
+ * @param[in] def definition; overlapping spans are merged, holidays outside
+ *            the range are ignored
+ * @param[in] first_year first KST calendar year covered
+ * @param[in] last_year last KST calendar year covered
+ * @return fastkst_bizhours_t* compiled table, NULL on failure (errno set)
+ */
+fastkst_bizhours_t *fastkst_bizhours_compile(const fastkst_bizhours_def_t *def,
+                                             int first_year, int last_year);
+
+/**
+ * @brief Free a compiled table
+ */
+void fastkst_bizhours_free(fastkst_bizhours_t *bh);
+
+/**
+ * @brief Business seconds in [t1, t2)
+ * @param[out] out seconds; negative when t2 < t1
+ * @return int 1 on success, 0 on failure
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer)
+ *       - ERANGE: t1 or t2 is outside the compiled years
+ */
+int fastkst_business_seconds(const fastkst_bizhours_t *bh, time_t t1, time_t t2,
+                             int64_t *out);
+
+/**
+ * @brief Instant at which secs business seconds after t have elapsed
+ * @param[in] secs business seconds, negative to go back
+ * @param[out] out earliest u with fastkst_business_seconds(t, u) == secs
+ *             (t itself when secs is 0); a deadline ending with a span is
+ *             the span's end, not the next opening
+ * @return int 1 on success, 0 on failure (EINVAL, ERANGE)
+ */
+int fastkst_add_business_seconds(const fastkst_bizhours_t *bh, time_t t,
+                                 int64_t secs, time_t *out);
+
+/**
+ * @brief Batch version of fastkst_business_seconds()
+ * @return size_t number of elements computed; less than n on failure
+ */
+size_t fastkst_business_seconds_batch(const fastkst_bizhours_t *bh,
+                                      const time_t *t1, const time_t *t2,
+                                      size_t n, int64_t *out);
+
+/**
+ * @brief Batch version of fastkst_add_business_seconds()
+ * @return size_t number of elements computed; less than n on failure
+ */
+size_t fastkst_add_business_seconds_batch(const fastkst_bizhours_t *bh,
+                                          const time_t *t, const int64_t *secs,
+                                          size_t n, time_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_BIZHOURS_H */
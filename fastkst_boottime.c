@@ -0,0 +1,392 @@
+/**
+ * @file fastkst_boottime.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief CLOCK_MONOTONIC / CLOCK_BOOTTIME timestamps to KST (UTC+9)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Batch conversion goes through __offtime64() once per KST day; rows that
+ *    fall on the same day as the previous row only recompute H:M:S.
+ *  - Test code: enabled with TEST_FASTKST_BOOTTIME
+ */
+#include <time.h>
+#include <stdint.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fastkst_boottime.h"
+#include "fastkst_internal.h"
+
+#define NSEC_PER_SEC    1000000000LL
+#define SNAPSHOT_TRIES  5
+
+static int64_t clock_ns(clockid_t id, int *ok)
+{
+  struct timespec ts;
+
+  if (clock_gettime(id, &ts) != 0) {
+    *ok = 0;
+    return 0;
+  }
+  return (int64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+/* offset = realtime - src, taken from the narrowest src/realtime/src window */
+static int sample_offset(clockid_t src, int64_t *offset, int64_t *realtime)
+{
+  int64_t best_window = INT64_MAX;
+  int ok = 1;
+  int i;
+
+  for (i = 0; i < SNAPSHOT_TRIES; i++) {
+    int64_t s0 = clock_ns(src, &ok);
+    int64_t rt = clock_ns(CLOCK_REALTIME, &ok);
+    int64_t s1 = clock_ns(src, &ok);
+
+    if (!ok)
+      return 0;
+    if (s1 - s0 < best_window) {
+      best_window = s1 - s0;
+      *offset = rt - (s0 + (s1 - s0) / 2);
+      *realtime = rt;
+    }
+  }
+  return 1;
+}
+
+int fastkst_clock_snapshot_capture(fastkst_clock_snapshot_t *snap)
+{
+  int64_t rt;
+
+  if (snap == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (!sample_offset(CLOCK_MONOTONIC, &snap->mono_offset_ns, &rt))
+    return 0;
+  if (!sample_offset(CLOCK_BOOTTIME, &snap->boot_offset_ns, &snap->realtime_ns))
+    return 0;
+
+  return 1;
+}
+
+int fastkst_clock_snapshot_save(const fastkst_clock_snapshot_t *snap,
+                                const char *path)
+{
+  FILE *fp;
+  int ok;
+
+  if (snap == NULL || path == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  fp = fopen(path, "w");
+  if (fp == NULL)
+    return 0;
+
+  ok = fprintf(fp, "# fastkst clock snapshot\n"
+                   "realtime_ns=%lld\n"
+                   "mono_offset_ns=%lld\n"
+                   "boot_offset_ns=%lld\n",
+               (long long)snap->realtime_ns,
+               (long long)snap->mono_offset_ns,
+               (long long)snap->boot_offset_ns) > 0;
+
+  if (fclose(fp) != 0)
+    ok = 0;
+  return ok;
+}
+
+int fastkst_clock_snapshot_load(fastkst_clock_snapshot_t *snap,
+                                const char *path)
+{
+  FILE *fp;
+  char line[128];
+  long long v;
+  int seen = 0;
+
+  if (snap == NULL || path == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  fp = fopen(path, "r");
+  if (fp == NULL)
+    return 0;
+
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    if (sscanf(line, "realtime_ns=%lld", &v) == 1) {
+      snap->realtime_ns = v;
+      seen |= 1;
+    } else if (sscanf(line, "mono_offset_ns=%lld", &v) == 1) {
+      snap->mono_offset_ns = v;
+      seen |= 2;
+    } else if (sscanf(line, "boot_offset_ns=%lld", &v) == 1) {
+      snap->boot_offset_ns = v;
+      seen |= 4;
+    }
+  }
+  fclose(fp);
+
+  if (seen != 7) {
+    errno = EINVAL;
+    return 0;
+  }
+  return 1;
+}
+
+int64_t fastkst_clock_to_realtime_ns(const fastkst_clock_snapshot_t *snap,
+                                     fastkst_clock_src_t src, int64_t ns)
+{
+  return ns + (src == FASTKST_CLOCK_BOOTTIME ? snap->boot_offset_ns
+                                             : snap->mono_offset_ns);
+}
+
+/* fastkst_clock_to_realtime_ns() for the batch paths: EOVERFLOW on wrap */
+static inline int to_realtime_checked(const fastkst_clock_snapshot_t *snap,
+                                      fastkst_clock_src_t src, int64_t ns, int64_t *rt)
+{
+  if (__builtin_add_overflow(ns, src == FASTKST_CLOCK_BOOTTIME ? snap->boot_offset_ns
+                                                             : snap->mono_offset_ns, rt)) {
+    errno = EOVERFLOW;
+    return 0;
+  }
+  return 1;
+}
+
+/* Per-batch cache of the last decomposed KST day */
+typedef struct {
+  int64_t day_start;   /* UTC epoch second of the cached KST midnight */
+  struct tm day;       /* date fields of that day */
+  int valid;
+} day_cache_t;
+
+static int convert_cached(day_cache_t *cache, int64_t sec, struct tm *tp)
+{
+  int64_t rem = sec - cache->day_start;
+
+  if (!cache->valid || rem < 0 || rem >= SECS_PER_DAY) {
+    if (__offtime64((time_t)sec, KST_OFFSET, &cache->day) != 1)
+      return 0;
+    fastkst_set_zone(&cache->day);
+    cache->day_start = sec - (cache->day.tm_hour * SECS_PER_HOUR
+                              + cache->day.tm_min * 60 + cache->day.tm_sec);
+    cache->valid = 1;
+    *tp = cache->day;
+    return 1;
+  }
+
+  *tp = cache->day;
+  tp->tm_hour = (int)(rem / SECS_PER_HOUR);
+  rem %= SECS_PER_HOUR;
+  tp->tm_min = (int)(rem / 60);
+  tp->tm_sec = (int)(rem % 60);
+  return 1;
+}
+
+size_t fastkst_clock_to_tm_batch(const fastkst_clock_snapshot_t *snap,
+                                 fastkst_clock_src_t src,
+                                 const int64_t *ns, size_t n,
+                                 struct tm *out, long *out_nsec)
+{
+  day_cache_t cache;
+  size_t i;
+
+  if (snap == NULL || (n > 0 && (ns == NULL || out == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  cache.valid = 0;
+  for (i = 0; i < n; i++) {
+    int64_t rt, sec;
+
+    if (!to_realtime_checked(snap, src, ns[i], &rt))
+      return i;
+    sec = fastkst_floor_div(rt, NSEC_PER_SEC);
+    if (!convert_cached(&cache, sec, &out[i]))
+      return i;
+    if (out_nsec)
+      out_nsec[i] = (long)(rt - sec * NSEC_PER_SEC);
+  }
+  return n;
+}
+
+size_t fastkst_clock_format_batch(const fastkst_clock_snapshot_t *snap,
+                                  fastkst_clock_src_t src,
+                                  const int64_t *ns, size_t n,
+                                  char *buf, size_t stride, int precision)
+{
+  day_cache_t cache;
+  struct tm tm;
+  size_t i;
+
+  if (snap == NULL || (n > 0 && (ns == NULL || buf == NULL)) ||
+      precision < 0 || precision > 9 ||
+      stride < (size_t)(20 + (precision > 0 ? precision + 1 : 0))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  cache.valid = 0;
+  for (i = 0; i < n; i++) {
+    int64_t rt, sec;
+    char *p = buf + i * stride;
+
+    if (!to_realtime_checked(snap, src, ns[i], &rt))
+      return i;
+    sec = fastkst_floor_div(rt, NSEC_PER_SEC);
+    if (!convert_cached(&cache, sec, &tm))
+      return i;
+
+    fastkst_put_datetime(p, &tm);
+    p += 19;
+    if (precision > 0) {
+      uint32_t frac = (uint32_t)(rt - sec * NSEC_PER_SEC);
+      int d;
+
+      for (d = precision; d < 9; d++)
+        frac /= 10;
+      *p++ = '.';
+      for (d = precision - 1; d >= 0; d--) {
+        p[d] = (char)('0' + frac % 10);
+        frac /= 10;
+      }
+      p += precision;
+    }
+    *p = '\0';
+  }
+  return n;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_BOOTTIME
+/* 빌드 방법
+gcc -DTEST_FASTKST_BOOTTIME -o fastkst_boottime_test fastkst_boottime.c fastkst_localtime.c
+./fastkst_boottime_test
+*/
+#include <stdlib.h>
+#include <unistd.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+int main(void)
+{
+  fastkst_clock_snapshot_t snap, loaded;
+  struct timespec mono, real;
+  int64_t ns[4];
+  struct tm tms[4], ref;
+  long nsec[4];
+  char buf[4][32];
+  char path[] = "/tmp/fastkst_snapshot_XXXXXX";
+  int fd;
+  size_t i;
+
+  printf("=== FASTKST_BOOTTIME Test ===\n\n");
+
+  CHECK(fastkst_clock_snapshot_capture(&snap) == 1, "capture snapshot");
+
+  /* Current monotonic time must map to (about) current realtime */
+  clock_gettime(CLOCK_MONOTONIC, &mono);
+  clock_gettime(CLOCK_REALTIME, &real);
+  {
+    int64_t m = (int64_t)mono.tv_sec * NSEC_PER_SEC + mono.tv_nsec;
+    int64_t r = (int64_t)real.tv_sec * NSEC_PER_SEC + real.tv_nsec;
+    int64_t diff = fastkst_clock_to_realtime_ns(&snap, FASTKST_CLOCK_MONOTONIC, m) - r;
+    CHECK(diff > -10000000 && diff < 10000000, "monotonic offset within 10ms");
+  }
+
+  /* Fixed snapshot: monotonic 0 == 2025-12-31 12:00:00 KST */
+  snap.realtime_ns = 1767150000LL * NSEC_PER_SEC;
+  snap.mono_offset_ns = 1767150000LL * NSEC_PER_SEC;
+  snap.boot_offset_ns = 1767150000LL * NSEC_PER_SEC - 5 * NSEC_PER_SEC;
+
+  ns[0] = 0;
+  ns[1] = 45 * NSEC_PER_SEC + 123456789;                   /* 12:00:45 */
+  ns[2] = 12 * 3600 * NSEC_PER_SEC;                         /* next day */
+  ns[3] = -1;                                               /* 11:59:59.999999999 */
+
+  CHECK(fastkst_clock_to_tm_batch(&snap, FASTKST_CLOCK_MONOTONIC, ns, 4, tms, nsec) == 4,
+        "tm batch converts all rows");
+  for (i = 0; i < 4; i++) {
+    fastkst_localtime((time_t)fastkst_floor_div(
+                        fastkst_clock_to_realtime_ns(&snap, FASTKST_CLOCK_MONOTONIC, ns[i]),
+                        NSEC_PER_SEC), &ref);
+    CHECK(tms[i].tm_year == ref.tm_year && tms[i].tm_yday == ref.tm_yday &&
+          tms[i].tm_mday == ref.tm_mday && tms[i].tm_wday == ref.tm_wday &&
+          tms[i].tm_hour == ref.tm_hour && tms[i].tm_min == ref.tm_min &&
+          tms[i].tm_sec == ref.tm_sec && tms[i].tm_gmtoff == ref.tm_gmtoff,
+          "tm batch matches fastkst_localtime()");
+  }
+  CHECK(nsec[1] == 123456789 && nsec[3] == 999999999, "sub-second nanoseconds");
+
+  CHECK(fastkst_clock_format_batch(&snap, FASTKST_CLOCK_MONOTONIC, ns, 4,
+                                   &buf[0][0], sizeof(buf[0]), 6) == 4,
+        "format batch converts all rows");
+  CHECK(strcmp(buf[0], "2025-12-31 12:00:00.000000") == 0, "format row 0");
+  CHECK(strcmp(buf[1], "2025-12-31 12:00:45.123456") == 0, "format row 1");
+  CHECK(strcmp(buf[2], "2026-01-01 00:00:00.000000") == 0, "format row 2 (day change)");
+  CHECK(strcmp(buf[3], "2025-12-31 11:59:59.999999") == 0, "format row 3 (negative ns)");
+
+  CHECK(fastkst_clock_format_batch(&snap, FASTKST_CLOCK_BOOTTIME, ns, 1,
+                                   &buf[0][0], sizeof(buf[0]), 0) == 1 &&
+        strcmp(buf[0], "2025-12-31 11:59:55") == 0, "boottime source, precision 0");
+
+  CHECK(fastkst_clock_format_batch(&snap, FASTKST_CLOCK_MONOTONIC, ns, 1,
+                                   &buf[0][0], 20, 3) == 0 && errno == EINVAL,
+        "stride too small rejected");
+
+  /* realtime past INT64_MAX ns fails instead of wrapping to 17xx
+     (kst_trace "[9000000000.000000]" and -n "9223372036854775000") */
+  snap.mono_offset_ns = 1792249200LL * NSEC_PER_SEC;       /* 2026-10-18 KST */
+  ns[0] = 9000000000LL * NSEC_PER_SEC;
+  ns[1] = 9223372036854775000LL;
+  for (i = 0; i < 2; i++) {
+    errno = 0;
+    CHECK(fastkst_clock_format_batch(&snap, FASTKST_CLOCK_MONOTONIC, &ns[i], 1,
+                                     &buf[0][0], sizeof(buf[0]), 6) == 0 && errno == EOVERFLOW,
+          "format batch: realtime overflow rejected");
+    errno = 0;
+    CHECK(fastkst_clock_to_tm_batch(&snap, FASTKST_CLOCK_MONOTONIC, &ns[i], 1, tms, NULL) == 0 &&
+          errno == EOVERFLOW, "tm batch: realtime overflow rejected");
+  }
+  snap.mono_offset_ns = 1767150000LL * NSEC_PER_SEC;
+
+  /* Save / load round trip */
+  fd = mkstemp(path);
+  if (fd >= 0)
+    close(fd);
+  CHECK(fastkst_clock_snapshot_save(&snap, path) == 1, "save snapshot");
+  memset(&loaded, 0, sizeof(loaded));
+  CHECK(fastkst_clock_snapshot_load(&loaded, path) == 1 &&
+        memcmp(&loaded, &snap, sizeof(snap)) == 0, "load snapshot round trip");
+  unlink(path);
+  CHECK(fastkst_clock_snapshot_load(&loaded, path) == 0, "missing file rejected");
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All boottime tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d boottime test(s) failed!\n", failures);
+  return 1;
+}
+#endif
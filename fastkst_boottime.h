@@ -0,0 +1,148 @@
+/**
+ * @file fastkst_boottime.h
+ * @brief CLOCK_MONOTONIC / CLOCK_BOOTTIME timestamps to KST (UTC+9)
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Kernel logs (dmesg), perf and eBPF tracers record boot-relative
+ *    nanoseconds. A clock snapshot captures the realtime offset of both
+ *    clocks once, so whole arrays can be converted without syscalls.
+ *  - Snapshots can be saved to a file and loaded later for offline
+ *    conversion of traces taken on another boot or another host.
+ *  - The offset is only valid for the boot it was captured on, and drifts
+ *    with NTP adjustments of CLOCK_REALTIME; capture close to the trace.
+ */
+
+#ifndef FASTKST_BOOTTIME_H
+#define FASTKST_BOOTTIME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Source clock of the timestamps being converted
+ */
+typedef enum {
+  FASTKST_CLOCK_MONOTONIC = 0,
+  FASTKST_CLOCK_BOOTTIME  = 1
+} fastkst_clock_src_t;
+
+/**
+ * @brief Realtime offsets of the boot-relative clocks (nanoseconds)
+ *
+ * realtime_ns = src_ns + mono_offset_ns (or boot_offset_ns)
+ */
+typedef struct {
+  int64_t realtime_ns;     /**< CLOCK_REALTIME at capture time */
+  int64_t mono_offset_ns;  /**< CLOCK_REALTIME - CLOCK_MONOTONIC */
+  int64_t boot_offset_ns;  /**< CLOCK_REALTIME - CLOCK_BOOTTIME */
+} fastkst_clock_snapshot_t;
+
+/**
+ * @brief Capture the current clock offsets
+ * @param[out] snap snapshot to fill
+ * @return int 1 on success, 0 on failure
+ *
+ * @note Each offset is sampled several times and the reading with the
+ *       narrowest bracketing window is kept, so preemption between the two
+ *       clock_gettime() calls does not skew the result.
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer)
+ *       - any errno set by clock_gettime()
+ */
+int fastkst_clock_snapshot_capture(fastkst_clock_snapshot_t *snap);
+
+/**
+ * @brief Save a snapshot as a small text file
+ * @param[in] snap snapshot to save
+ * @param[in] path output file path
+ * @return int 1 on success, 0 on failure (errno set)
+ */
+int fastkst_clock_snapshot_save(const fastkst_clock_snapshot_t *snap,
+                                const char *path);
+
+/**
+ * @brief Load a snapshot written by fastkst_clock_snapshot_save()
+ * @param[out] snap snapshot to fill
+ * @param[in] path snapshot file path
+ * @return int 1 on success, 0 on failure
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument or malformed file
+ *       - any errno set by fopen()
+ */
+int fastkst_clock_snapshot_load(fastkst_clock_snapshot_t *snap,
+                                const char *path);
+
+/**
+ * @brief Convert one boot-relative timestamp to realtime nanoseconds
+ * @param[in] snap clock snapshot
+ * @param[in] src clock the timestamp was taken with
+ * @param[in] ns boot-relative nanoseconds
+ * @return int64_t nanoseconds since the Unix epoch
+ *
+ * @note The sum is not range checked and wraps past INT64_MAX; the batch
+ *       functions below fail with EOVERFLOW instead.
+ */
+int64_t fastkst_clock_to_realtime_ns(const fastkst_clock_snapshot_t *snap,
+                                     fastkst_clock_src_t src, int64_t ns);
+
+/**
+ * @brief Convert boot-relative timestamps to KST struct tm in batch
+ * @param[in] snap clock snapshot
+ * @param[in] src clock the timestamps were taken with
+ * @param[in] ns array of boot-relative nanoseconds
+ * @param[in] n number of elements
+ * @param[out] out n struct tm results (KST)
+ * @param[out] out_nsec sub-second nanoseconds per element (optional, can be NULL)
+ * @return size_t number of elements converted; less than n on failure
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer)
+ *       - EOVERFLOW: Realtime nanoseconds overflow int64_t, or year exceeds
+ *         struct tm range
+ */
+size_t fastkst_clock_to_tm_batch(const fastkst_clock_snapshot_t *snap,
+                                 fastkst_clock_src_t src,
+                                 const int64_t *ns, size_t n,
+                                 struct tm *out, long *out_nsec);
+
+/**
+ * @brief Format boot-relative timestamps as KST text in batch
+ * @param[in] snap clock snapshot
+ * @param[in] src clock the timestamps were taken with
+ * @param[in] ns array of boot-relative nanoseconds
+ * @param[in] n number of elements
+ * @param[out] buf output buffer, one NUL-terminated string every stride bytes
+ * @param[in] stride bytes per output string: at least 20, plus precision + 1
+ *            when precision > 0
+ * @param[in] precision fraction digits, 0..9
+ * @return size_t number of elements formatted; less than n on failure
+ *
+ * @note Layout: "YYYY-MM-DD HH:MM:SS[.fffffffff]"
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer, bad precision, stride too small)
+ *       - EOVERFLOW: Realtime nanoseconds overflow int64_t, or year exceeds
+ *         struct tm range
+ */
+size_t fastkst_clock_format_batch(const fastkst_clock_snapshot_t *snap,
+                                  fastkst_clock_src_t src,
+                                  const int64_t *ns, size_t n,
+                                  char *buf, size_t stride, int precision);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_BOOTTIME_H */
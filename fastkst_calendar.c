@@ -0,0 +1,138 @@
+/**
+ * @file fastkst_calendar.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief KST (UTC+9) calendar windows computed from epoch seconds
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - local = t + 9h; window = floor((local - anchor) / unit).
+ *    The anchor is 0 except for weeks, which start on Monday
+ *    (1970-01-01 was a Thursday, so the anchor is 3 days earlier).
+ *  - Test code: enabled with TEST_FASTKST_CALENDAR
+ */
+#include <time.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include "fastkst_calendar.h"
+#include "fastkst_internal.h"
+
+static const int64_t unit_secs[4] = {
+  60, SECS_PER_HOUR, SECS_PER_DAY, 7 * SECS_PER_DAY
+};
+
+static const int64_t unit_anchor[4] = {
+  0, 0, 0, -3 * SECS_PER_DAY
+};
+
+int64_t fastkst_unit_seconds(fastkst_unit_t unit)
+{
+  if ((unsigned)unit > FASTKST_UNIT_WEEK)
+    return 0;
+  return unit_secs[unit];
+}
+
+int64_t fastkst_window_index(time_t t, fastkst_unit_t unit)
+{
+  if ((unsigned)unit > FASTKST_UNIT_WEEK)
+    unit = FASTKST_UNIT_DAY;
+  return fastkst_floor_div((int64_t)t + KST_OFFSET - unit_anchor[unit],
+                           unit_secs[unit]);
+}
+
+time_t fastkst_window_start(int64_t index, fastkst_unit_t unit)
+{
+  if ((unsigned)unit > FASTKST_UNIT_WEEK)
+    unit = FASTKST_UNIT_DAY;
+  return (time_t)(index * unit_secs[unit] + unit_anchor[unit] - KST_OFFSET);
+}
+
+time_t fastkst_next_boundary(time_t t, fastkst_unit_t unit, int64_t phase)
+{
+  int64_t k;
+
+  if ((unsigned)unit > FASTKST_UNIT_WEEK || phase < 0 || phase >= unit_secs[unit]) {
+    errno = EINVAL;
+    return (time_t)-1;
+  }
+
+  k = fastkst_floor_div((int64_t)t + KST_OFFSET - unit_anchor[unit] - phase,
+                        unit_secs[unit]);
+  return (time_t)((k + 1) * unit_secs[unit] + unit_anchor[unit] + phase - KST_OFFSET);
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_CALENDAR
+/* 빌드 방법
+gcc -DTEST_FASTKST_CALENDAR -o fastkst_calendar_test fastkst_calendar.c fastkst_localtime.c
+./fastkst_calendar_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+int main(void)
+{
+  int failures = 0;
+  int i;
+
+  printf("=== FASTKST_CALENDAR Test ===\n\n");
+
+  /* Random times against fastkst_localtime() */
+  srand(12345);
+  for (i = 0; i < 200000; i++) {
+    time_t t = (time_t)((((int64_t)rand() << 20) ^ rand()) % 8000000000LL) - 2000000000LL;
+    struct tm tm;
+    time_t day0, b;
+    int64_t want;
+
+    fastkst_localtime(t, &tm);
+    day0 = t - (tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec);
+
+    if (fastkst_window_start(fastkst_window_index(t, FASTKST_UNIT_DAY), FASTKST_UNIT_DAY) != day0 ||
+        fastkst_window_start(fastkst_window_index(t, FASTKST_UNIT_HOUR), FASTKST_UNIT_HOUR)
+          != day0 + tm.tm_hour * 3600 ||
+        fastkst_window_start(fastkst_window_index(t, FASTKST_UNIT_WEEK), FASTKST_UNIT_WEEK)
+          != day0 - ((tm.tm_wday + 6) % 7) * SECS_PER_DAY) {
+      if (failures++ < 5)
+        printf("[FAIL] window start for %lld\n", (long long)t);
+    }
+
+    /* next 09:00 KST */
+    b = fastkst_next_boundary(t, FASTKST_UNIT_DAY, 9 * 3600);
+    want = day0 + 9 * 3600;
+    if (want <= t)
+      want += SECS_PER_DAY;
+    if (b != want) {
+      if (failures++ < 5)
+        printf("[FAIL] next 09:00 boundary for %lld\n", (long long)t);
+    }
+  }
+
+  /* 2025-12-31 12:52:45 KST (Wednesday) -> Monday 2026-01-05 09:00 KST */
+  if (fastkst_next_boundary(1767153165, FASTKST_UNIT_WEEK, 9 * 3600) != 1767571200) {
+    printf("[FAIL] next Monday 09:00\n");
+    failures++;
+  }
+  /* exactly on a boundary: the next one is returned */
+  if (fastkst_next_boundary(1767106800, FASTKST_UNIT_DAY, 0) != 1767106800 + SECS_PER_DAY) {
+    printf("[FAIL] boundary is strictly after t\n");
+    failures++;
+  }
+  if (fastkst_next_boundary(0, FASTKST_UNIT_HOUR, 3600) != (time_t)-1 || errno != EINVAL) {
+    printf("[FAIL] out of range phase rejected\n");
+    failures++;
+  }
+
+  if (failures == 0) {
+    printf("[PASS] All calendar tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d calendar test(s) failed!\n", failures);
+  return 1;
+}
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file fastkst_calendar.h
+ * @brief KST (UTC+9) calendar windows computed from epoch seconds
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Windows are numbered from the Unix epoch in KST with the fixed +9 offset,
+ *    without struct tm, localtime() or mktime().
+ *  - Week windows start on Monday 00:00 KST.
+ */
+
+#ifndef FASTKST_CALENDAR_H
+#define FASTKST_CALENDAR_H
+
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Calendar unit of a KST window
+ */
+typedef enum {
+  FASTKST_UNIT_MINUTE = 0,
+  FASTKST_UNIT_HOUR   = 1,
+  FASTKST_UNIT_DAY    = 2,
+  FASTKST_UNIT_WEEK   = 3
+} fastkst_unit_t;
+
+/**
+ * @brief Length of a unit in seconds (0 for an unknown unit)
+ */
+int64_t fastkst_unit_seconds(fastkst_unit_t unit);
+
+/**
+ * @brief Index of the KST window containing t
+ * @param[in] t time_t
+ * @param[in] unit window unit
+ * @return int64_t window number (window 0 contains 1970-01-01 00:00 KST;
+ *         for weeks, the week of Monday 1969-12-29)
+ */
+int64_t fastkst_window_index(time_t t, fastkst_unit_t unit);
+
+/**
+ * @brief First second (UTC epoch) of a KST window
+ * @param[in] index window number from fastkst_window_index()
+ * @param[in] unit window unit
+ * @return time_t start of the window
+ */
+time_t fastkst_window_start(int64_t index, fastkst_unit_t unit);
+
+/**
+ * @brief Next KST calendar boundary strictly after t
+ * @param[in] t time_t
+ * @param[in] unit boundary unit
+ * @param[in] phase seconds into the unit, 0 <= phase < unit length
+ *                  (e.g. FASTKST_UNIT_WEEK with 9 * 3600 is Monday 09:00 KST)
+ * @return time_t the boundary, or (time_t)-1 with errno = EINVAL on bad arguments
+ */
+time_t fastkst_next_boundary(time_t t, fastkst_unit_t unit, int64_t phase);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_CALENDAR_H */
@@ -0,0 +1,228 @@
+/**
+ * @file fastkst_core.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Freestanding timestamp decomposition for eBPF and bare-metal targets
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Same civil-from-days arithmetic as fastkst_civil_from_days(), but
+ *    counted from 0000-03-01 so every intermediate value is non-negative
+ *    and divisions are unsigned (BPF has no signed division before cpu v4).
+ *  - Only 32-bit divisions: 86400 = 128 * 675 and the supported range
+ *    shifted right by 7 fits in 32 bits, so 32-bit MCUs need no
+ *    __udivdi3 / __divdi3 from libgcc.
+ *  - Must not include any header but fastkst_core.h outside the test code.
+ *  - Test code: enabled with TEST_FASTKST_CORE
+ */
+#include "fastkst_core.h"
+
+typedef __UINT32_TYPE__ core_u32;
+typedef __UINT64_TYPE__ core_u64;
+
+/* Days from 0000-03-01 to 1970-01-01 */
+#define CORE_DAYS_TO_EPOCH  719468
+
+static inline int core_isleap(core_u32 y)
+{
+  return (y % 4 == 0) & ((y % 100 != 0) | (y % 400 == 0));
+}
+
+/* Local time (t + offset) in range, as days and seconds of day since 0000-03-01 */
+static inline int core_local(fastkst_core_i64 t, fastkst_core_i32 offset,
+                             core_u32 *days, core_u32 *sod)
+{
+  core_u64 s;
+  core_u32 q;
+
+  if (offset <= -86400 || offset >= 86400 ||
+      t < FASTKST_CORE_MIN_LOCAL - 86400 || t > FASTKST_CORE_MAX_LOCAL + 86400)
+    return 0;
+  t += offset;
+  if (t < FASTKST_CORE_MIN_LOCAL || t > FASTKST_CORE_MAX_LOCAL)
+    return 0;
+  s = (core_u64)(t + (fastkst_core_i64)CORE_DAYS_TO_EPOCH * 86400);
+  q = (core_u32)(s >> 7);                                           /* < 2^32 */
+  *days = q / 675;
+  *sod = (q - *days * 675) * 128 + (core_u32)(s & 127);
+  return 1;
+}
+
+FASTKST_CORE_API int fastkst_core_offtime(fastkst_core_i64 t, fastkst_core_i32 offset,
+                                          fastkst_core_tm_t *tp)
+{
+  core_u32 days, sod, era, doe, yoe, doy, mp, y;
+
+  if (!core_local(t, offset, &days, &sod))
+    return 0;
+
+  era = days / 146097;
+  doe = days - era * 146097;                                        /* [0, 146096] */
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;      /* [0, 399] */
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                    /* [0, 365], from March 1 */
+  mp = (5 * doy + 2) / 153;                                         /* [0, 11], March = 0 */
+  y = era * 400 + yoe + (mp >= 10);
+
+  tp->year = (fastkst_core_i32)y - 1900;
+  tp->mon = (fastkst_core_i32)(mp < 10 ? mp + 2 : mp - 10);
+  tp->mday = (fastkst_core_i32)(doy - (153 * mp + 2) / 5 + 1);
+  tp->hour = (fastkst_core_i32)(sod / 3600);
+  tp->min = (fastkst_core_i32)(sod / 60 % 60);
+  tp->sec = (fastkst_core_i32)(sod % 60);
+  /* 0000-03-01 was a Wednesday */
+  tp->wday = (fastkst_core_i32)((days + 3) % 7);
+  tp->yday = (fastkst_core_i32)(mp < 10 ? doy + 59 + core_isleap(y) : doy - 306);
+  return 1;
+}
+
+FASTKST_CORE_API int fastkst_core_epoch_day(fastkst_core_i64 t, fastkst_core_i32 offset,
+                                            fastkst_core_i64 *day)
+{
+  core_u32 days, sod;
+
+  if (!core_local(t, offset, &days, &sod))
+    return 0;
+  *day = (fastkst_core_i64)days - CORE_DAYS_TO_EPOCH;
+  return 1;
+}
+
+FASTKST_CORE_API int fastkst_core_mktime(const fastkst_core_tm_t *tp, fastkst_core_i32 offset,
+                                         fastkst_core_i64 *t)
+{
+  core_u32 y, m, mlen, era, yoe, mp, doy, days;
+
+  if (offset <= -86400 || offset >= 86400 ||
+      tp->year < 1 - 1900 || tp->year > 9999 - 1900 || tp->mon < 0 || tp->mon > 11 ||
+      tp->hour < 0 || tp->hour > 23 || tp->min < 0 || tp->min > 59 ||
+      tp->sec < 0 || tp->sec > 59 || tp->mday < 1)
+    return 0;
+
+  y = (core_u32)(tp->year + 1900);
+  m = (core_u32)tp->mon + 1;
+  /* 31 for Jan, Mar, May, Jul, Aug, Oct, Dec */
+  mlen = m == 2 ? 28 + (core_u32)core_isleap(y) : 30 + ((m + (m >> 3)) & 1);
+  if ((core_u32)tp->mday > mlen)
+    return 0;
+
+  y -= m <= 2;
+  era = y / 400;
+  yoe = y - era * 400;                                              /* [0, 399] */
+  mp = m > 2 ? m - 3 : m + 9;                                       /* March = 0 */
+  doy = (153 * mp + 2) / 5 + (core_u32)tp->mday - 1;                /* [0, 365] */
+  days = era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  *t = ((fastkst_core_i64)days - CORE_DAYS_TO_EPOCH) * 86400 +
+       tp->hour * 3600 + tp->min * 60 + tp->sec - offset;
+  return 1;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_CORE
+/* 빌드 방법
+gcc -DTEST_FASTKST_CORE -o fastkst_core_test fastkst_core.c fastkst_localtime.c
+./fastkst_core_test
+
+BPF 오브젝트
+clang -target bpf -O2 -ffreestanding -nostdinc -c fastkst_core.c -o fastkst_core.bpf.o
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+int __offtime64(time_t t, long int offset, struct tm *tp);
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static int same_as_offtime(fastkst_core_i64 t, fastkst_core_i32 offset)
+{
+  fastkst_core_tm_t c;
+  fastkst_core_i64 back, day;
+  struct tm tm;
+
+  if (!fastkst_core_offtime(t, offset, &c) || !__offtime64((time_t)t, offset, &tm))
+    return 0;
+  if (c.year != tm.tm_year || c.mon != tm.tm_mon || c.mday != tm.tm_mday ||
+      c.hour != tm.tm_hour || c.min != tm.tm_min || c.sec != tm.tm_sec ||
+      c.wday != tm.tm_wday || c.yday != tm.tm_yday)
+    return 0;
+  if (!fastkst_core_epoch_day(t, offset, &day) ||
+      day * 86400 > t + offset || (day + 1) * 86400 <= t + offset)
+    return 0;
+  return fastkst_core_mktime(&c, offset, &back) && back == t;
+}
+
+int main(void)
+{
+  const fastkst_core_i32 offsets[] = { FASTKST_CORE_KST_OFFSET, 0, -36000, 50400, 86399, -86399 };
+  fastkst_core_tm_t c;
+  fastkst_core_i64 t;
+  int i, j, bad;
+
+  printf("=== FASTKST_CORE Test ===\n\n");
+
+  CHECK(fastkst_core_offtime(1767193200, FASTKST_CORE_KST_OFFSET, &c) &&
+        c.year == 126 && c.mon == 0 && c.mday == 1 && c.hour == 0 && c.wday == 4 && c.yday == 0,
+        "2026-01-01 00:00 KST");
+  CHECK(fastkst_core_offtime(FASTKST_CORE_MIN_LOCAL - 32400, 32400, &c) &&
+        c.year == 1 - 1900 && c.mon == 0 && c.mday == 1 && c.wday == 1,
+        "0001-01-01 (Monday)");
+  CHECK(fastkst_core_offtime(FASTKST_CORE_MAX_LOCAL - 32400, 32400, &c) &&
+        c.year == 9999 - 1900 && c.mon == 11 && c.mday == 31 && c.sec == 59 && c.yday == 364,
+        "9999-12-31 23:59:59");
+  CHECK(!fastkst_core_offtime(FASTKST_CORE_MIN_LOCAL - 32400 - 1, 32400, &c) &&
+        !fastkst_core_offtime(FASTKST_CORE_MAX_LOCAL - 32400 + 1, 32400, &c) &&
+        !fastkst_core_offtime(0x7fffffffffffffffLL, 0, &c) &&
+        !fastkst_core_offtime(-0x7fffffffffffffffLL - 1, 0, &c) &&
+        !fastkst_core_offtime(0, 86400, &c), "out of range rejected");
+
+  c.year = 124; c.mon = 1; c.mday = 29; c.hour = 0; c.min = 0; c.sec = 0;
+  CHECK(fastkst_core_mktime(&c, 32400, &t) && t == 1709132400, "mktime 2024-02-29 KST");
+  c.year = 123;
+  CHECK(!fastkst_core_mktime(&c, 32400, &t), "mktime rejects 2023-02-29");
+  c.year = 200; c.mday = 29;
+  CHECK(!fastkst_core_mktime(&c, 32400, &t), "mktime rejects 2100-02-29");
+  c.year = 100; c.mon = 10; c.mday = 31;
+  CHECK(!fastkst_core_mktime(&c, 32400, &t), "mktime rejects 2000-11-31");
+
+  /* Against __offtime64() over the whole range and several offsets */
+  bad = 0;
+  srand(89);
+  for (j = 0; j < (int)(sizeof(offsets) / sizeof(offsets[0])); j++) {
+    fastkst_core_i64 lo = FASTKST_CORE_MIN_LOCAL - offsets[j];
+    fastkst_core_i64 span = FASTKST_CORE_MAX_LOCAL - FASTKST_CORE_MIN_LOCAL + 1;
+
+    bad += !same_as_offtime(lo, offsets[j]) || !same_as_offtime(lo + span - 1, offsets[j]);
+    for (i = 0; i < 200000; i++) {
+      fastkst_core_i64 r = ((fastkst_core_i64)rand() << 31 ^ rand()) % span;
+      bad += !same_as_offtime(lo + r, offsets[j]);
+    }
+  }
+  CHECK(bad == 0, "matches __offtime64() and round-trips through mktime");
+
+  /* Every day boundary of 1900..2100 */
+  bad = 0;
+  for (t = -2208988800LL - 32400; t < 4133980800LL; t += 86400)
+    bad += !same_as_offtime(t, 32400) || !same_as_offtime(t - 1, 32400);
+  CHECK(bad == 0, "every KST midnight 1900..2100");
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All core tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d core test(s) failed!\n", failures);
+  return 1;
+}
+#endif
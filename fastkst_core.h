@@ -0,0 +1,95 @@
+/**
+ * @file fastkst_core.h
+ * @brief Freestanding timestamp decomposition for eBPF and bare-metal targets
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - No libc: this header and fastkst_core.c include nothing, use no errno
+ *    and call no function. Integer types come from the compiler's
+ *    __INT32_TYPE__ / __INT64_TYPE__ macros (gcc, clang).
+ *  - No loops, and every division is an unsigned division by a constant,
+ *    so the code passes the BPF verifier and needs no libgcc helpers.
+ *  - Supported local dates: 0001-01-01 00:00:00 .. 9999-12-31 23:59:59.
+ *  - `make bpf` builds fastkst_core.bpf.o with clang -target bpf; the host
+ *    build is part of the library and tested by fastkst_core_test.
+ *  - To inline the functions into a BPF program instead of linking the
+ *    object, define FASTKST_CORE_API (e.g. as
+ *    `static __attribute__((always_inline)) inline`) and include
+ *    fastkst_core.c.
+ */
+
+#ifndef FASTKST_CORE_H
+#define FASTKST_CORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FASTKST_CORE_API
+#define FASTKST_CORE_API
+#endif
+
+typedef __INT32_TYPE__ fastkst_core_i32;
+typedef __INT64_TYPE__ fastkst_core_i64;
+
+/** KST offset for the offset arguments */
+#define FASTKST_CORE_KST_OFFSET   32400
+
+/** Supported range of t + offset (0001-01-01 .. 9999-12-31 23:59:59) */
+#define FASTKST_CORE_MIN_LOCAL    (-62135596800LL)
+#define FASTKST_CORE_MAX_LOCAL    253402300799LL
+
+/**
+ * @brief Broken-down time (struct tm field conventions, without the zone)
+ */
+typedef struct {
+  fastkst_core_i32 year;      /**< years since 1900 */
+  fastkst_core_i32 mon;       /**< 0..11 */
+  fastkst_core_i32 mday;      /**< 1..31 */
+  fastkst_core_i32 hour;
+  fastkst_core_i32 min;
+  fastkst_core_i32 sec;
+  fastkst_core_i32 wday;      /**< 0..6, Sunday = 0 */
+  fastkst_core_i32 yday;      /**< 0..365 */
+} fastkst_core_tm_t;
+
+/**
+ * @brief Decompose a timestamp (__offtime64() without libc)
+ * @param[in] t seconds since the epoch
+ * @param[in] offset UTC offset in seconds, |offset| < 86400
+ *            (FASTKST_CORE_KST_OFFSET for KST)
+ * @param[out] tp result
+ * @return int 1 success, 0 when offset or t + offset is out of range
+ *         (tp is left untouched)
+ */
+FASTKST_CORE_API int fastkst_core_offtime(fastkst_core_i64 t, fastkst_core_i32 offset,
+                                          fastkst_core_tm_t *tp);
+
+/**
+ * @brief Epoch day (1970-01-01 = 0) of t in the given offset
+ * @param[out] day result
+ * @return int 1 success, 0 when out of range
+ */
+FASTKST_CORE_API int fastkst_core_epoch_day(fastkst_core_i64 t, fastkst_core_i32 offset,
+                                            fastkst_core_i64 *day);
+
+/**
+ * @brief Inverse of fastkst_core_offtime()
+ * @param[in] tp year, mon, mday, hour, min, sec (wday and yday are ignored);
+ *            fields must be in range, tm_sec = 60 is rejected
+ * @param[in] offset UTC offset in seconds, |offset| < 86400
+ * @param[out] t result
+ * @return int 1 success, 0 on an out-of-range field
+ */
+FASTKST_CORE_API int fastkst_core_mktime(const fastkst_core_tm_t *tp, fastkst_core_i32 offset,
+                                         fastkst_core_i64 *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_CORE_H */
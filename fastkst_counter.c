@@ -0,0 +1,361 @@
+/**
+ * @file fastkst_counter.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Lock-free fixed-window counters that reset at KST calendar boundaries
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Bucket word: [63..40] window tag (window index mod 2^24), [39..0] count.
+ *    A bucket holding an older tag is rotated by CAS-ing in (tag, delta);
+ *    tags are compared as 24-bit serial numbers to tell late events apart.
+ *    A zero word is an empty bucket and is taken by any window: the tag
+ *    0 it holds would look older or newer depending on the window index.
+ *  - Shard = sched_getcpu() % nshards. Threads migrating between CPUs only
+ *    cost a CAS retry, never a lost update.
+ *  - Test code: enabled with TEST_FASTKST_COUNTER
+ */
+#define _GNU_SOURCE
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#include "fastkst_counter.h"
+
+#define CACHELINE       64
+#define TAG_SHIFT       40
+#define TAG_MASK        ((1ULL << 24) - 1)
+#define COUNT_MASK      ((1ULL << TAG_SHIFT) - 1)
+#define MAX_BUCKETS     1024
+
+struct fastkst_counter {
+  fastkst_unit_t unit;
+  unsigned nbuckets;
+  unsigned nshards;
+  size_t stride;                  /* words per shard, a multiple of a cache line */
+  _Atomic uint64_t *words;        /* nshards * stride, cache-line aligned */
+};
+
+static inline uint64_t window_tag(int64_t w)
+{
+  return (uint64_t)w & TAG_MASK;
+}
+
+/* Signed distance between two 24-bit tags */
+static inline int32_t tag_diff(uint64_t a, uint64_t b)
+{
+  return (int32_t)(((a - b) & TAG_MASK) << 8) >> 8;
+}
+
+static inline unsigned bucket_of(const fastkst_counter_t *c, int64_t w)
+{
+  int64_t r = w % (int64_t)c->nbuckets;
+  return (unsigned)(r < 0 ? r + c->nbuckets : r);
+}
+
+fastkst_counter_t *fastkst_counter_create(fastkst_unit_t unit, unsigned nbuckets,
+                                          unsigned nshards)
+{
+  fastkst_counter_t *c;
+  size_t bytes;
+
+  if (fastkst_unit_seconds(unit) == 0 || nbuckets == 0 || nbuckets > MAX_BUCKETS) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  if (nshards == 0) {
+    long ncpu = sysconf(_SC_NPROCESSORS_CONF);
+    nshards = ncpu > 0 ? (unsigned)ncpu : 1;
+  }
+
+  c = malloc(sizeof(*c));
+  if (c == NULL)
+    return NULL;
+
+  c->unit = unit;
+  c->nbuckets = nbuckets;
+  c->nshards = nshards;
+  c->stride = (nbuckets * sizeof(uint64_t) + CACHELINE - 1) / CACHELINE
+              * (CACHELINE / sizeof(uint64_t));
+
+  bytes = c->stride * sizeof(uint64_t) * nshards;
+  c->words = aligned_alloc(CACHELINE, bytes);
+  if (c->words == NULL) {
+    free(c);
+    return NULL;
+  }
+  memset((void *)c->words, 0, bytes);
+  return c;
+}
+
+void fastkst_counter_destroy(fastkst_counter_t *c)
+{
+  if (c == NULL)
+    return;
+  free((void *)c->words);
+  free(c);
+}
+
+int fastkst_counter_add(fastkst_counter_t *c, time_t t, uint32_t delta)
+{
+  int64_t w = fastkst_window_index(t, c->unit);
+  uint64_t tag = window_tag(w);
+  int cpu = sched_getcpu();
+  unsigned shard = cpu < 0 ? 0 : (unsigned)cpu % c->nshards;
+  _Atomic uint64_t *b = &c->words[shard * c->stride + bucket_of(c, w)];
+  uint64_t v = atomic_load_explicit(b, memory_order_relaxed);
+
+  for (;;) {
+    uint64_t cur = v >> TAG_SHIFT;
+    uint64_t next;
+
+    if (cur == tag)                                /* saturate: never carry into the tag */
+      next = (v & COUNT_MASK) + delta > COUNT_MASK ? (tag << TAG_SHIFT) | COUNT_MASK : v + delta;
+    else if (v == 0 || tag_diff(tag, cur) > 0)
+      next = (tag << TAG_SHIFT) | delta;           /* take an empty bucket or rotate */
+    else
+      return 0;                                    /* window already rotated out */
+
+    if (atomic_compare_exchange_weak_explicit(b, &v, next, memory_order_relaxed,
+                                              memory_order_relaxed))
+      return 1;
+  }
+}
+
+static uint64_t window_total(const fastkst_counter_t *c, int64_t w)
+{
+  uint64_t tag = window_tag(w);
+  unsigned bucket = bucket_of(c, w);
+  uint64_t sum = 0;
+  unsigned s;
+
+  for (s = 0; s < c->nshards; s++) {
+    uint64_t v = atomic_load_explicit(&c->words[s * c->stride + bucket],
+                                      memory_order_relaxed);
+    if ((v >> TAG_SHIFT) == tag)
+      sum += v & COUNT_MASK;
+  }
+  return sum;
+}
+
+uint64_t fastkst_counter_get(const fastkst_counter_t *c, time_t t)
+{
+  return window_total(c, fastkst_window_index(t, c->unit));
+}
+
+size_t fastkst_counter_history(const fastkst_counter_t *c, time_t now,
+                               uint64_t *out, size_t n)
+{
+  int64_t w = fastkst_window_index(now, c->unit);
+  size_t i;
+
+  if (n > c->nbuckets)
+    n = c->nbuckets;
+  for (i = 0; i < n; i++)
+    out[i] = window_total(c, w - (int64_t)i);
+  return n;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_COUNTER
+/* 빌드 방법
+gcc -DTEST_FASTKST_COUNTER -o fastkst_counter_test fastkst_counter.c fastkst_calendar.c fastkst_localtime.c -lpthread
+./fastkst_counter_test
+*/
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#define BENCH_OPS_PER_THREAD 1000000
+#define MAX_THREADS 32
+
+static fastkst_counter_t *bench_counter;
+static const time_t bench_base = 1767193200;   /* 2026-01-01 00:00:00 KST */
+
+/* Baseline: localtime_r + date key + locked map lookup */
+typedef struct { int key; uint64_t count; } map_entry_t;
+static map_entry_t map_entries[64];
+static pthread_mutex_t map_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void baseline_add(time_t t)
+{
+  struct tm tm;
+  int key, i;
+
+  localtime_r(&t, &tm);
+  key = (tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday;
+  pthread_mutex_lock(&map_lock);
+  for (i = 0; i < 64; i++) {
+    if (map_entries[i].key == key || map_entries[i].key == 0) {
+      map_entries[i].key = key;
+      map_entries[i].count++;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&map_lock);
+}
+
+static void *bench_fast(void *arg)
+{
+  long i;
+  (void)arg;
+  for (i = 0; i < BENCH_OPS_PER_THREAD; i++)
+    fastkst_counter_add(bench_counter, bench_base + (i & 1023), 1);
+  return NULL;
+}
+
+static void *bench_baseline(void *arg)
+{
+  long i;
+  (void)arg;
+  for (i = 0; i < BENCH_OPS_PER_THREAD; i++)
+    baseline_add(bench_base + (i & 1023));
+  return NULL;
+}
+
+static double get_time_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec * 1000000.0 + (double)tv.tv_usec;
+}
+
+static double run_threads(void *(*fn)(void *), int nthreads)
+{
+  pthread_t th[MAX_THREADS];
+  double start, end;
+  int i;
+
+  start = get_time_usec();
+  for (i = 0; i < nthreads; i++)
+    pthread_create(&th[i], NULL, fn, NULL);
+  for (i = 0; i < nthreads; i++)
+    pthread_join(th[i], NULL);
+  end = get_time_usec();
+  return (end - start) * 1000.0 / ((double)BENCH_OPS_PER_THREAD * nthreads);
+}
+
+int main(void)
+{
+  fastkst_counter_t *c;
+  uint64_t hist[8];
+  int failures = 0;
+  int nthreads;
+  long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+
+  printf("=== FASTKST_COUNTER Test ===\n\n");
+
+  /* Day windows reset at KST midnight, not UTC midnight */
+  c = fastkst_counter_create(FASTKST_UNIT_DAY, 4, 1);
+  fastkst_counter_add(c, bench_base - 1, 5);        /* 2025-12-31 23:59:59 KST */
+  fastkst_counter_add(c, bench_base, 7);            /* 2026-01-01 00:00:00 KST */
+  fastkst_counter_add(c, bench_base + 14 * 3600, 1);/* still 2026-01-01 KST (UTC day changed) */
+  if (fastkst_counter_get(c, bench_base - 86399) != 5 || fastkst_counter_get(c, bench_base + 86399) != 8) {
+    printf("[FAIL] KST midnight boundary\n");
+    failures++;
+  } else {
+    printf("[PASS] KST midnight boundary\n");
+  }
+
+  /* Rolling history and rotation */
+  fastkst_counter_add(c, bench_base + 86400 * 2, 3);
+  fastkst_counter_history(c, bench_base + 86400 * 2, hist, 8);
+  if (hist[0] != 3 || hist[1] != 0 || hist[2] != 8 || hist[3] != 5) {
+    printf("[FAIL] history %llu %llu %llu %llu\n", (unsigned long long)hist[0],
+           (unsigned long long)hist[1], (unsigned long long)hist[2], (unsigned long long)hist[3]);
+    failures++;
+  } else {
+    printf("[PASS] rolling history\n");
+  }
+  fastkst_counter_add(c, bench_base + 86400 * 4, 1);       /* rotates 2026-01-01 out of its bucket */
+  if (fastkst_counter_get(c, bench_base) != 0 || fastkst_counter_add(c, bench_base, 1) != 0) {
+    printf("[FAIL] rotated window / late event\n");
+    failures++;
+  } else {
+    printf("[PASS] rotated window dropped, late event rejected\n");
+  }
+  fastkst_counter_destroy(c);
+
+  /* A full 40-bit count saturates instead of spilling into the window tag */
+  c = fastkst_counter_create(FASTKST_UNIT_DAY, 4, 1);
+  {
+    int k, ok = 1;
+    for (k = 0; k < 300; k++)
+      ok &= fastkst_counter_add(c, bench_base, UINT32_MAX);
+    ok &= fastkst_counter_add(c, bench_base + 60, 1);
+    if (!ok || fastkst_counter_get(c, bench_base) != COUNT_MASK ||
+        fastkst_counter_get(c, bench_base + 86400) != 0) {
+      printf("[FAIL] count saturation\n");
+      failures++;
+    } else {
+      printf("[PASS] count saturates at 2^40 - 1\n");
+    }
+  }
+  fastkst_counter_destroy(c);
+
+  /* Empty buckets accept any window: minute tags near 2026 are >= 2^23 */
+  {
+    static const fastkst_unit_t units[] = { FASTKST_UNIT_MINUTE, FASTKST_UNIT_HOUR };
+    const time_t now = 1792300000;                   /* 2026-10-18 KST */
+    int k, ok = 1;
+
+    for (k = 0; k < 2; k++) {
+      time_t step = (time_t)fastkst_unit_seconds(units[k]);
+
+      c = fastkst_counter_create(units[k], 60, 1);
+      ok &= fastkst_counter_add(c, now, 1) == 1 && fastkst_counter_add(c, now, 2) == 1;
+      ok &= fastkst_counter_add(c, now - step, 4) == 1;   /* older window, empty bucket */
+      ok &= fastkst_counter_add(c, now + 60 * step, 1) == 1 &&
+            fastkst_counter_add(c, now, 1) == 0;          /* rotated out: late */
+      fastkst_counter_history(c, now + 60 * step, hist, 2);
+      ok &= fastkst_counter_get(c, now - step) == 4 && fastkst_counter_get(c, now) == 0 &&
+            hist[0] == 1 && hist[1] == 0;
+      fastkst_counter_destroy(c);
+    }
+    if (!ok) {
+      printf("[FAIL] minute / hour windows at current timestamps\n");
+      failures++;
+    } else {
+      printf("[PASS] minute / hour windows at current timestamps\n");
+    }
+  }
+
+  /* Benchmark: exact totals under contention */
+  printf("\n=== Performance Benchmark ===\n\n");
+  for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 4) {
+    double fast_ns, base_ns;
+    uint64_t total;
+
+    bench_counter = fastkst_counter_create(FASTKST_UNIT_DAY, 8, 0);
+    fast_ns = run_threads(bench_fast, nthreads);
+    total = fastkst_counter_get(bench_counter, bench_base);
+    fastkst_counter_destroy(bench_counter);
+
+    memset(map_entries, 0, sizeof(map_entries));
+    base_ns = run_threads(bench_baseline, nthreads);
+
+    printf("Threads: %2d  fastkst_counter_add(): %7.2f ns/op   localtime_r+mutex: %7.2f ns/op\n",
+           nthreads, fast_ns, base_ns);
+    if (total != (uint64_t)BENCH_OPS_PER_THREAD * nthreads) {
+      printf("[FAIL] lost updates: %llu\n", (unsigned long long)total);
+      failures++;
+    }
+  }
+  printf("(online CPUs: %ld)\n\n", ncpu);
+
+  if (failures == 0) {
+    printf("[PASS] All counter tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d counter test(s) failed!\n", failures);
+  return 1;
+}
+#endif
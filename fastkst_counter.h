@@ -0,0 +1,83 @@
+/**
+ * @file fastkst_counter.h
+ * @brief Lock-free fixed-window counters that reset at KST calendar boundaries
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Quota / fraud counters that reset at KST midnight (or hour, minute, week).
+ *  - The window is computed with fastkst_window_index(): +9 offset arithmetic,
+ *    no struct tm, no localtime_r().
+ *  - Each CPU increments its own cache-line padded shard; a shard keeps a
+ *    ring of nbuckets windows, so the last nbuckets windows can be reported.
+ *  - Every bucket packs (window tag, count) into one 64-bit word and rotates
+ *    with a single compare-and-swap: no locks on any path.
+ */
+
+#ifndef FASTKST_COUNTER_H
+#define FASTKST_COUNTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "fastkst_calendar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct fastkst_counter fastkst_counter_t;
+
+/**
+ * @brief Create a counter
+ * @param[in] unit window unit (reset boundary)
+ * @param[in] nbuckets windows of history kept, 1..1024
+ * @param[in] nshards number of shards, 0 for one per configured CPU
+ * @return fastkst_counter_t* counter, NULL on failure (errno set)
+ */
+fastkst_counter_t *fastkst_counter_create(fastkst_unit_t unit, unsigned nbuckets,
+                                          unsigned nshards);
+
+/**
+ * @brief Destroy a counter
+ */
+void fastkst_counter_destroy(fastkst_counter_t *c);
+
+/**
+ * @brief Add to the window containing t
+ * @param[in] c counter
+ * @param[in] t time of the event
+ * @param[in] delta amount to add
+ * @return int 1 on success, 0 if the window has already rotated out of the
+ *         shard's history (late event, not counted)
+ *
+ * @note A shard's count per window saturates at 2^40 - 1.
+ */
+int fastkst_counter_add(fastkst_counter_t *c, time_t t, uint32_t delta);
+
+/**
+ * @brief Total of the window containing t, summed over all shards
+ * @return uint64_t the total, 0 if the window is not in the history
+ */
+uint64_t fastkst_counter_get(const fastkst_counter_t *c, time_t t);
+
+/**
+ * @brief Rolling history ending at the window containing now
+ * @param[in] c counter
+ * @param[in] now reference time
+ * @param[out] out out[0] = current window, out[k] = k windows earlier
+ * @param[in] n entries wanted (clamped to nbuckets)
+ * @return size_t number of entries written
+ */
+size_t fastkst_counter_history(const fastkst_counter_t *c, time_t now,
+                               uint64_t *out, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_COUNTER_H */
@@ -0,0 +1,459 @@
+/**
+ * @file fastkst_datedim.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Date dimension rows (one per KST day) for data warehouses
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - ISO weeks: the starting row gets its week from the day of year and
+ *    weekday ((doy - wday + 10) / 7, moved to the neighbouring ISO year when
+ *    it falls outside 1..weeks); afterwards every Monday advances the week.
+ *  - CSV rows are assembled by hand into a 64 KiB buffer and written with
+ *    fwrite(), no printf() per field.
+ *  - Test code: enabled with TEST_FASTKST_DATEDIM
+ */
+#include <time.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "fastkst_datedim.h"
+#include "fastkst_internal.h"
+
+#define MIN_YEAR    1
+#define MAX_YEAR    9999
+#define CSV_BUFSIZE (64 * 1024)
+#define CSV_MAXROW  128
+
+/* 53 if the ISO year has 53 weeks (starts on Thursday, or leap and Wednesday) */
+static inline int iso_weeks_in(int64_t y)
+{
+#define P(y) ((((y) + fastkst_floor_div(y, 4) - fastkst_floor_div(y, 100) + \
+                fastkst_floor_div(y, 400)) % 7 + 7) % 7)
+  return (P(y) == 4 || P(y - 1) == 3) ? 53 : 52;
+#undef P
+}
+
+static inline uint8_t flags_of(const fastkst_date_t *d, int leap)
+{
+  uint8_t f = leap ? FASTKST_DATE_LEAP_YEAR : 0;
+  int q_month = d->month % 3;
+
+  if (d->weekday >= 6)
+    f |= FASTKST_DATE_WEEKEND;
+  if (d->day == 1) {
+    f |= FASTKST_DATE_MONTH_START;
+    if (q_month == 1)
+      f |= FASTKST_DATE_QUARTER_START;
+    if (d->month == 1)
+      f |= FASTKST_DATE_YEAR_START;
+  }
+  if (d->day == d->days_in_month) {
+    f |= FASTKST_DATE_MONTH_END;
+    if (q_month == 0)
+      f |= FASTKST_DATE_QUARTER_END;
+    if (d->month == 12)
+      f |= FASTKST_DATE_YEAR_END;
+  }
+  return f;
+}
+
+static inline int8_t days_in(int leap, int month)
+{
+  const unsigned short int *ip = __mon_yday[leap];
+  return (int8_t)(ip[month] - ip[month - 1]);
+}
+
+int64_t fastkst_datedim_epoch_day(int year, int month, int day)
+{
+  return fastkst_days_from_civil(year, month, day);
+}
+
+int fastkst_datedim_iter_init(fastkst_datedim_iter_t *it, int64_t first_day)
+{
+  fastkst_date_t *d;
+  struct tm tm;
+  int leap, w;
+
+  if (it == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (first_day < fastkst_days_from_civil(MIN_YEAR, 1, 1) ||
+      first_day > fastkst_days_from_civil(MAX_YEAR, 12, 31)) {
+    errno = ERANGE;
+    return 0;
+  }
+
+  /* the only full decomposition; the epoch day is the same in any frame */
+  __offtime64((time_t)(first_day * SECS_PER_DAY), 0, &tm);
+
+  d = &it->cur;
+  d->epoch_day = (int32_t)first_day;
+  d->year = (int16_t)(tm.tm_year + 1900);
+  d->month = (int8_t)(tm.tm_mon + 1);
+  d->day = (int8_t)tm.tm_mday;
+  d->quarter = (int8_t)(tm.tm_mon / 3 + 1);
+  d->day_of_year = (int16_t)(tm.tm_yday + 1);
+  d->weekday = (int8_t)(tm.tm_wday == 0 ? 7 : tm.tm_wday);
+  d->date_key = d->year * 10000 + d->month * 100 + d->day;
+  leap = __isleap(d->year);
+  d->days_in_month = days_in(leap, d->month);
+
+  w = (d->day_of_year - d->weekday + 10) / 7;
+  if (w < 1) {
+    d->iso_year = (int16_t)(d->year - 1);
+    w = iso_weeks_in(d->iso_year);
+  } else if (w > iso_weeks_in(d->year)) {
+    d->iso_year = (int16_t)(d->year + 1);
+    w = 1;
+  } else {
+    d->iso_year = d->year;
+  }
+  d->iso_week = (int8_t)w;
+  it->iso_weeks = iso_weeks_in(d->iso_year);
+  d->flags = flags_of(d, leap);
+  it->done = 0;
+  return 1;
+}
+
+static inline void step(fastkst_datedim_iter_t *it)
+{
+  fastkst_date_t *d = &it->cur;
+  int leap = (d->flags & FASTKST_DATE_LEAP_YEAR) != 0;
+
+  d->epoch_day++;
+  d->day_of_year++;
+  d->weekday = (int8_t)(d->weekday == 7 ? 1 : d->weekday + 1);
+
+  if (d->day < d->days_in_month) {
+    d->day++;
+  } else {
+    d->day = 1;
+    if (d->month < 12) {
+      d->month++;
+    } else {
+      if (d->year == MAX_YEAR)
+        it->done = 1;
+      d->year++;
+      d->month = 1;
+      d->day_of_year = 1;
+      leap = __isleap(d->year);
+    }
+    d->quarter = (int8_t)((d->month + 2) / 3);
+    d->days_in_month = days_in(leap, d->month);
+  }
+
+  if (d->weekday == 1) {
+    if (d->iso_week == it->iso_weeks) {
+      d->iso_week = 1;
+      d->iso_year++;
+      it->iso_weeks = iso_weeks_in(d->iso_year);
+    } else {
+      d->iso_week++;
+    }
+  }
+
+  d->date_key = d->year * 10000 + d->month * 100 + d->day;
+  d->flags = flags_of(d, leap);
+}
+
+int fastkst_datedim_next(fastkst_datedim_iter_t *it, fastkst_date_t *out)
+{
+  if (it == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (it->done) {
+    errno = ERANGE;
+    return 0;
+  }
+  *out = it->cur;
+  step(it);
+  return 1;
+}
+
+size_t fastkst_datedim_rows(int64_t first_day, size_t n, fastkst_date_t *out)
+{
+  fastkst_datedim_iter_t it;
+  size_t i;
+
+  if (n > 0 && out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (n == 0 || !fastkst_datedim_iter_init(&it, first_day))
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    if (!fastkst_datedim_next(&it, &out[i]))
+      return i;
+  }
+  return n;
+}
+
+size_t fastkst_datedim_fill(int64_t first_day, size_t n,
+                            const fastkst_datedim_cols_t *cols)
+{
+  fastkst_datedim_iter_t it;
+  const fastkst_date_t *d = &it.cur;
+  size_t i;
+
+  if (cols == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (n == 0 || !fastkst_datedim_iter_init(&it, first_day))
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    if (it.done) {
+      errno = ERANGE;
+      return i;
+    }
+    if (cols->date_key)     cols->date_key[i] = d->date_key;
+    if (cols->epoch_day)    cols->epoch_day[i] = d->epoch_day;
+    if (cols->year)         cols->year[i] = d->year;
+    if (cols->quarter)      cols->quarter[i] = d->quarter;
+    if (cols->month)        cols->month[i] = d->month;
+    if (cols->day)          cols->day[i] = d->day;
+    if (cols->day_of_year)  cols->day_of_year[i] = d->day_of_year;
+    if (cols->weekday)      cols->weekday[i] = d->weekday;
+    if (cols->iso_week)     cols->iso_week[i] = d->iso_week;
+    if (cols->iso_year)     cols->iso_year[i] = d->iso_year;
+    if (cols->flags)        cols->flags[i] = d->flags;
+    step(&it);
+  }
+  return n;
+}
+
+/* Decimal, no padding; returns the end */
+static inline char *put_int(char *p, int64_t v)
+{
+  char tmp[20];
+  int n = 0;
+  uint64_t u;
+
+  if (v < 0) {
+    *p++ = '-';
+    u = (uint64_t)0 - (uint64_t)v;
+  } else {
+    u = (uint64_t)v;
+  }
+  do {
+    tmp[n++] = (char)('0' + u % 10);
+    u /= 10;
+  } while (u);
+  while (n)
+    *p++ = tmp[--n];
+  return p;
+}
+
+static inline char *put_flag(char *p, const fastkst_date_t *d, uint8_t bit)
+{
+  *p++ = ',';
+  *p++ = (d->flags & bit) ? '1' : '0';
+  return p;
+}
+
+static char *put_row(char *p, const fastkst_date_t *d)
+{
+  p = put_int(p, d->date_key);
+  *p++ = ',';
+  fastkst_put2(p, (unsigned)d->year / 100);
+  fastkst_put2(p + 2, (unsigned)d->year % 100);
+  p[4] = '-';
+  fastkst_put2(p + 5, (unsigned)d->month);
+  p[7] = '-';
+  fastkst_put2(p + 8, (unsigned)d->day);
+  p += 10;
+  *p++ = ',';  p = put_int(p, d->epoch_day);
+  *p++ = ',';  p = put_int(p, d->year);
+  *p++ = ',';  *p++ = (char)('0' + d->quarter);
+  *p++ = ',';  p = put_int(p, d->month);
+  *p++ = ',';  p = put_int(p, d->day);
+  *p++ = ',';  p = put_int(p, d->day_of_year);
+  *p++ = ',';  *p++ = (char)('0' + d->weekday);
+  *p++ = ',';  p = put_int(p, d->iso_year);
+  *p++ = ',';  p = put_int(p, d->iso_week);
+  *p++ = ',';  p = put_int(p, d->days_in_month);
+  p = put_flag(p, d, FASTKST_DATE_WEEKEND);
+  p = put_flag(p, d, FASTKST_DATE_MONTH_START);
+  p = put_flag(p, d, FASTKST_DATE_MONTH_END);
+  p = put_flag(p, d, FASTKST_DATE_QUARTER_START);
+  p = put_flag(p, d, FASTKST_DATE_QUARTER_END);
+  p = put_flag(p, d, FASTKST_DATE_YEAR_START);
+  p = put_flag(p, d, FASTKST_DATE_YEAR_END);
+  *p++ = '\n';
+  return p;
+}
+
+int fastkst_datedim_write_csv(FILE *fp, int64_t first_day, size_t n, int header)
+{
+  static const char head[] =
+    "date_key,date,epoch_day,year,quarter,month,day,day_of_year,weekday,"
+    "iso_year,iso_week,days_in_month,is_weekend,is_month_start,is_month_end,"
+    "is_quarter_start,is_quarter_end,is_year_start,is_year_end\n";
+  fastkst_datedim_iter_t it;
+  char buf[CSV_BUFSIZE];
+  char *p = buf;
+  size_t i;
+
+  if (fp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (n > 0 && !fastkst_datedim_iter_init(&it, first_day))
+    return 0;
+
+  if (header) {
+    memcpy(p, head, sizeof(head) - 1);
+    p += sizeof(head) - 1;
+  }
+  for (i = 0; i < n; i++) {
+    if (it.done) {
+      errno = ERANGE;
+      return 0;
+    }
+    p = put_row(p, &it.cur);
+    step(&it);
+    if (p > buf + CSV_BUFSIZE - CSV_MAXROW) {
+      if (fwrite(buf, 1, (size_t)(p - buf), fp) != (size_t)(p - buf))
+        return 0;
+      p = buf;
+    }
+  }
+  if (p > buf && fwrite(buf, 1, (size_t)(p - buf), fp) != (size_t)(p - buf))
+    return 0;
+  return 1;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_DATEDIM
+/* 빌드 방법
+gcc -DTEST_FASTKST_DATEDIM -o fastkst_datedim_test fastkst_datedim.c fastkst_localtime.c
+./fastkst_datedim_test
+*/
+#include <stdlib.h>
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+  const int64_t first = fastkst_datedim_epoch_day(1, 1, 1);
+  const size_t all = (size_t)(fastkst_datedim_epoch_day(9999, 12, 31) - first + 1);
+  fastkst_date_t *rows = malloc(all * sizeof(*rows));
+  fastkst_datedim_cols_t cols;
+  size_t i;
+  int bad;
+  double t0, t1;
+
+  printf("=== FASTKST_DATEDIM Test ===\n\n");
+
+  t0 = now_sec();
+  CHECK(fastkst_datedim_rows(first, all, rows) == all, "rows 0001-01-01 .. 9999-12-31");
+  t1 = now_sec();
+  printf("  %zu rows in %.1f ms\n", all, (t1 - t0) * 1e3);
+
+  /* Every row against __offtime64() + strftime() ISO week fields */
+  bad = 0;
+  for (i = 0; i < all; i++) {
+    const fastkst_date_t *d = &rows[i];
+    struct tm tm;
+    char iso[16];
+    int iy, iw;
+
+    __offtime64((time_t)((first + (int64_t)i) * SECS_PER_DAY), 0, &tm);
+    strftime(iso, sizeof(iso), "%G %V", &tm);
+    sscanf(iso, "%d %d", &iy, &iw);
+    if (d->epoch_day != first + (int64_t)i || d->year != tm.tm_year + 1900 ||
+        d->month != tm.tm_mon + 1 || d->day != tm.tm_mday ||
+        d->day_of_year != tm.tm_yday + 1 || d->weekday != (tm.tm_wday ? tm.tm_wday : 7) ||
+        d->quarter != tm.tm_mon / 3 + 1 || d->iso_year != iy || d->iso_week != iw ||
+        d->date_key != d->year * 10000 + d->month * 100 + d->day ||
+        !!(d->flags & FASTKST_DATE_WEEKEND) != (tm.tm_wday == 0 || tm.tm_wday == 6) ||
+        !!(d->flags & FASTKST_DATE_MONTH_END) != (i + 1 == all || rows[i + 1].day == 1) ||
+        !!(d->flags & FASTKST_DATE_YEAR_START) != (tm.tm_yday == 0))
+      bad++;
+  }
+  CHECK(bad == 0, "every row matches __offtime64() and strftime(%G %V)");
+
+  CHECK(fastkst_datedim_iter_init(&(fastkst_datedim_iter_t){ 0 }, first - 1) == 0 && errno == ERANGE,
+        "day before 0001-01-01 rejected");
+  CHECK(fastkst_datedim_rows(fastkst_datedim_epoch_day(9999, 12, 30), 3, rows) == 2,
+        "generation stops after 9999-12-31");
+
+  /* Columns: only some requested */
+  {
+    enum { N = 366 };
+    int32_t key[N];
+    int8_t week[N];
+    uint8_t flags[N];
+
+    memset(&cols, 0, sizeof(cols));
+    cols.date_key = key;
+    cols.iso_week = week;
+    cols.flags = flags;
+    CHECK(fastkst_datedim_fill(fastkst_datedim_epoch_day(2024, 1, 1), N, &cols) == N &&
+          key[0] == 20240101 && key[N - 1] == 20241231 && week[0] == 1 &&
+          week[N - 1] == 1 && (flags[59] & FASTKST_DATE_LEAP_YEAR) &&
+          (flags[91] & FASTKST_DATE_QUARTER_START), "column fill");
+  }
+
+  /* CSV */
+  {
+    FILE *fp = tmpfile();
+    char line[256];
+
+    CHECK(fp && fastkst_datedim_write_csv(fp, fastkst_datedim_epoch_day(2025, 12, 31), 2, 1), "write csv");
+    rewind(fp);
+    fgets(line, sizeof(line), fp);
+    CHECK(strncmp(line, "date_key,date,", 14) == 0, "csv header");
+    fgets(line, sizeof(line), fp);
+    CHECK(strcmp(line, "20251231,2025-12-31,20453,2025,4,12,31,365,3,2026,1,31,0,0,1,0,1,0,1\n") == 0,
+          "csv row 2025-12-31");
+    fgets(line, sizeof(line), fp);
+    CHECK(strcmp(line, "20260101,2026-01-01,20454,2026,1,1,1,1,4,2026,1,31,0,1,0,1,0,1,0\n") == 0,
+          "csv row 2026-01-01");
+    fclose(fp);
+
+    fp = fopen("/dev/null", "w");
+    t0 = now_sec();
+    fastkst_datedim_write_csv(fp, first, all, 1);
+    t1 = now_sec();
+    printf("  %zu csv rows in %.1f ms\n", all, (t1 - t0) * 1e3);
+    fclose(fp);
+  }
+
+  free(rows);
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All datedim tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d datedim test(s) failed!\n", failures);
+  return 1;
+}
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file fastkst_datedim.h
+ * @brief Date dimension rows (one per KST day) for data warehouses
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - The first day is decomposed once; every following row is derived from
+ *    the previous one (weekday rotation, month / year roll-over from
+ *    __mon_yday, ISO week counting Mondays), with no fastkst_localtime()
+ *    call per row.
+ *  - Supported range: 0001-01-01 .. 9999-12-31, so date_key (YYYYMMDD)
+ *    and the CSV layout stay fixed width.
+ */
+
+#ifndef FASTKST_DATEDIM_H
+#define FASTKST_DATEDIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* fastkst_date_t::flags */
+#define FASTKST_DATE_WEEKEND        0x01    /**< Saturday or Sunday */
+#define FASTKST_DATE_MONTH_START    0x02
+#define FASTKST_DATE_MONTH_END      0x04
+#define FASTKST_DATE_QUARTER_START  0x08
+#define FASTKST_DATE_QUARTER_END    0x10
+#define FASTKST_DATE_YEAR_START     0x20
+#define FASTKST_DATE_YEAR_END       0x40
+#define FASTKST_DATE_LEAP_YEAR      0x80
+
+/**
+ * @brief One date dimension row
+ */
+typedef struct {
+  int32_t date_key;           /**< YYYYMMDD */
+  int32_t epoch_day;          /**< days since 1970-01-01 (KST) */
+  int16_t year;
+  int8_t quarter;             /**< 1..4 */
+  int8_t month;               /**< 1..12 */
+  int8_t day;                 /**< 1..31 */
+  int8_t days_in_month;       /**< 28..31 */
+  int16_t day_of_year;        /**< 1..366 */
+  int8_t weekday;             /**< ISO: 1 = Monday .. 7 = Sunday */
+  int8_t iso_week;            /**< 1..53 */
+  int16_t iso_year;           /**< ISO 8601 week-numbering year */
+  uint8_t flags;              /**< FASTKST_DATE_* bits */
+} fastkst_date_t;
+
+/**
+ * @brief Row generator
+ */
+typedef struct {
+  fastkst_date_t cur;         /**< row returned by the next fastkst_datedim_next() */
+  int iso_weeks;              /**< 52 or 53, weeks in cur.iso_year */
+  int done;                   /**< past 9999-12-31 */
+} fastkst_datedim_iter_t;
+
+/**
+ * @brief Columnar output; any column may be NULL to skip it
+ */
+typedef struct {
+  int32_t *date_key;
+  int32_t *epoch_day;
+  int16_t *year;
+  int8_t *quarter;
+  int8_t *month;
+  int8_t *day;
+  int16_t *day_of_year;
+  int8_t *weekday;
+  int8_t *iso_week;
+  int16_t *iso_year;
+  uint8_t *flags;
+} fastkst_datedim_cols_t;
+
+/**
+ * @brief Epoch day (1970-01-01 = 0) of a civil date, for the first_day arguments
+ * @return int64_t epoch day; the date is not validated
+ */
+int64_t fastkst_datedim_epoch_day(int year, int month, int day);
+
+/**
+ * @brief Start a generator at a day
+ * @return int 1 on success, 0 on failure
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer)
+ *       - ERANGE: first_day is outside 0001-01-01 .. 9999-12-31
+ */
+int fastkst_datedim_iter_init(fastkst_datedim_iter_t *it, int64_t first_day);
+
+/**
+ * @brief Return the current row and step to the next day
+ * @return int 1 on success, 0 past 9999-12-31 (ERANGE)
+ */
+int fastkst_datedim_next(fastkst_datedim_iter_t *it, fastkst_date_t *out);
+
+/**
+ * @brief Fill n rows starting at first_day
+ * @return size_t number of rows written; less than n on failure
+ */
+size_t fastkst_datedim_rows(int64_t first_day, size_t n, fastkst_date_t *out);
+
+/**
+ * @brief Fill n rows starting at first_day into columns
+ * @return size_t number of rows written; less than n on failure
+ */
+size_t fastkst_datedim_fill(int64_t first_day, size_t n,
+                            const fastkst_datedim_cols_t *cols);
+
+/**
+ * @brief Write n rows starting at first_day as CSV
+ * @param[in] fp output stream
+ * @param[in] first_day epoch day of the first row
+ * @param[in] n number of rows
+ * @param[in] header non-zero to write the column names first
+ * @return int 1 on success, 0 on failure (ERANGE, or the stdio errno)
+ *
+ * @note Columns: date_key,date,epoch_day,year,quarter,month,day,
+ *       day_of_year,weekday,iso_year,iso_week,days_in_month,is_weekend,
+ *       is_month_start,is_month_end,is_quarter_start,is_quarter_end,
+ *       is_year_start,is_year_end
+ */
+int fastkst_datedim_write_csv(FILE *fp, int64_t first_day, size_t n, int header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_DATEDIM_H */
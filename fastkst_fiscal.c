@@ -0,0 +1,368 @@
+/**
+ * @file fastkst_fiscal.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Fiscal / retail calendars (custom year start, 4-4-5, 52/53-week) over KST
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - period_start[i * 12 + p] is the KST epoch day period p of compiled year i
+ *    starts on; period_start[nyears * 12] closes the last year. Years are
+ *    indexed by the calendar year they start in.
+ *  - Lookups take the KST epoch day the same way __offtime64() does
+ *    (floor((t + offset) / 86400)) and never build a struct tm.
+ *  - Test code: enabled with TEST_FASTKST_FISCAL
+ */
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include "fastkst_fiscal.h"
+#include "fastkst_internal.h"
+
+#define MAX_FISCAL_YEARS  100000
+
+struct fastkst_fiscal_cal {
+  fastkst_fiscal_def_t def;
+  int first_start_year;     /* calendar year compiled year 0 starts in */
+  int label_offset;         /* fiscal label = start year + label_offset */
+  int nyears;
+  int32_t *period_start;    /* nyears * 12 + 1 epoch days */
+};
+
+static const int8_t pattern_weeks[4][3] = {
+  { 0, 0, 0 },    /* monthly: unused */
+  { 4, 4, 5 },
+  { 4, 5, 4 },
+  { 5, 4, 4 }
+};
+
+static inline int64_t weekday_of(int64_t day)
+{
+  int64_t w = (day + 4) % 7;    /* January 1, 1970 was a Thursday. */
+  return w < 0 ? w + 7 : w;
+}
+
+/* First day of the retail year starting around start_month of calendar year s */
+static int64_t retail_year_start(const fastkst_fiscal_def_t *def, int64_t s)
+{
+  int64_t last = fastkst_days_from_civil(s, def->start_month, 1) - 1;
+  int64_t back = (weekday_of(last) - def->week_end_wday + 7) % 7;
+
+  if (def->year_end == FASTKST_FISCAL_END_NEAREST && back > 3)
+    back -= 7;
+  return last - back + 1;
+}
+
+fastkst_fiscal_cal_t *fastkst_fiscal_compile(const fastkst_fiscal_def_t *def,
+                                             int first_year, int last_year)
+{
+  fastkst_fiscal_cal_t *cal;
+  int i, p;
+
+  if (def == NULL || def->start_month < 1 || def->start_month > 12 ||
+      (unsigned)def->pattern > FASTKST_FISCAL_544 ||
+      (def->pattern != FASTKST_FISCAL_MONTHLY &&
+       (def->week_end_wday < 0 || def->week_end_wday > 6 ||
+        def->leap_week_period < 1 || def->leap_week_period > 12)) ||
+      last_year < first_year || last_year - first_year >= MAX_FISCAL_YEARS) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  cal = malloc(sizeof(*cal));
+  if (cal == NULL)
+    return NULL;
+
+  cal->def = *def;
+  cal->label_offset = (def->label_by_end && def->start_month != 1) ? 1 : 0;
+  cal->first_start_year = first_year - cal->label_offset;
+  cal->nyears = last_year - first_year + 1;
+  cal->period_start = malloc(((size_t)cal->nyears * 12 + 1) * sizeof(int32_t));
+  if (cal->period_start == NULL) {
+    free(cal);
+    return NULL;
+  }
+
+  for (i = 0; i <= cal->nyears; i++) {
+    int64_t s = (int64_t)cal->first_start_year + i;
+    int32_t *ps = &cal->period_start[i * 12];
+
+    if (def->pattern == FASTKST_FISCAL_MONTHLY) {
+      for (p = 0; p < (i < cal->nyears ? 12 : 1); p++) {
+        int m = def->start_month - 1 + p;
+        ps[p] = (int32_t)fastkst_days_from_civil(s + m / 12, m % 12 + 1, 1);
+      }
+    } else {
+      int64_t start = retail_year_start(def, s);
+      int64_t weeks;
+
+      ps[0] = (int32_t)start;
+      if (i == cal->nyears)
+        break;
+      weeks = (retail_year_start(def, s + 1) - start) / 7;
+      for (p = 1; p < 12; p++) {
+        int w = pattern_weeks[def->pattern][(p - 1) % 3];
+
+        if (weeks == 53 && p == def->leap_week_period)
+          w++;
+        ps[p] = ps[p - 1] + 7 * w;
+      }
+    }
+  }
+  return cal;
+}
+
+void fastkst_fiscal_free(fastkst_fiscal_cal_t *cal)
+{
+  if (cal == NULL)
+    return;
+  free(cal->period_start);
+  free(cal);
+}
+
+static inline int lookup_day(const fastkst_fiscal_cal_t *cal, int64_t day,
+                             fastkst_fiscal_t *out)
+{
+  const int32_t *ps = cal->period_start;
+  int64_t i, p, ys, ylen;
+  int n = cal->nyears;
+
+  if (day < ps[0] || day >= ps[(size_t)n * 12]) {
+    errno = ERANGE;
+    return 0;
+  }
+
+  /* guess from the mean Gregorian year, then correct by at most one */
+  i = (day - ps[0]) * 400 / 146097;
+  if (i >= n)
+    i = n - 1;
+  while (i > 0 && ps[i * 12] > day)
+    i--;
+  while (i < n - 1 && ps[(i + 1) * 12] <= day)
+    i++;
+
+  ps += i * 12;
+  ys = ps[0];
+  ylen = ps[12] - ys;
+
+  p = (day - ys) * 12 / ylen;
+  while (p > 0 && ps[p] > day)
+    p--;
+  while (p < 11 && ps[p + 1] <= day)
+    p++;
+
+  out->year = (int32_t)(cal->first_start_year + i + cal->label_offset);
+  out->period = (int8_t)(p + 1);
+  out->quarter = (int8_t)(p / 3 + 1);
+  out->day_of_year = (int16_t)(day - ys + 1);
+  out->week = (int8_t)((day - ys) / 7 + 1);
+  out->day_of_period = (int16_t)(day - ps[p] + 1);
+  out->week_of_period = (int8_t)((day - ps[p]) / 7 + 1);
+  return 1;
+}
+
+int fastkst_fiscal_lookup(const fastkst_fiscal_cal_t *cal, time_t t,
+                          fastkst_fiscal_t *out)
+{
+  if (cal == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  return lookup_day(cal, fastkst_floor_div((int64_t)t + KST_OFFSET, SECS_PER_DAY), out);
+}
+
+size_t fastkst_fiscal_lookup_batch(const fastkst_fiscal_cal_t *cal,
+                                   const time_t *t, size_t n,
+                                   fastkst_fiscal_t *out)
+{
+  size_t i;
+
+  if (cal == NULL || (n > 0 && (t == NULL || out == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (!lookup_day(cal, fastkst_floor_div((int64_t)t[i] + KST_OFFSET, SECS_PER_DAY), &out[i]))
+      return i;
+  }
+  return n;
+}
+
+int fastkst_fiscal_period_start(const fastkst_fiscal_cal_t *cal, int year,
+                                int period, time_t *start)
+{
+  int64_t i;
+
+  if (cal == NULL || start == NULL || period < 1 || period > 13) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  i = (int64_t)year - cal->label_offset - cal->first_start_year;
+  if (i < 0 || i >= cal->nyears) {
+    errno = ERANGE;
+    return 0;
+  }
+
+  *start = (time_t)((int64_t)cal->period_start[i * 12 + period - 1] * SECS_PER_DAY - KST_OFFSET);
+  return 1;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_FISCAL
+/* 빌드 방법
+gcc -DTEST_FASTKST_FISCAL -o fastkst_fiscal_test fastkst_fiscal.c fastkst_localtime.c
+./fastkst_fiscal_test
+*/
+#include <stdio.h>
+#include <string.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+static int failures = 0;
+
+/* Noon KST of a date */
+static time_t kst_noon(int y, int m, int d)
+{
+  return (time_t)(fastkst_days_from_civil(y, m, d) * SECS_PER_DAY + 12 * SECS_PER_HOUR - KST_OFFSET);
+}
+
+static void expect(const fastkst_fiscal_cal_t *cal, int y, int m, int d,
+                   int fy, int q, int p, int w)
+{
+  fastkst_fiscal_t f;
+
+  if (!fastkst_fiscal_lookup(cal, kst_noon(y, m, d), &f) ||
+      f.year != fy || f.quarter != q || f.period != p || f.week != w) {
+    printf("[FAIL] %04d-%02d-%02d: FY%d Q%d P%d W%d, want FY%d Q%d P%d W%d\n",
+           y, m, d, f.year, f.quarter, f.period, f.week, fy, q, p, w);
+    failures++;
+  } else {
+    printf("[PASS] %04d-%02d-%02d -> FY%d Q%d P%d W%d\n", y, m, d, fy, q, p, w);
+  }
+}
+
+int main(void)
+{
+  fastkst_fiscal_def_t def;
+  fastkst_fiscal_cal_t *cal;
+  fastkst_fiscal_t f;
+  int64_t day;
+  time_t start;
+
+  printf("=== FASTKST_FISCAL Test ===\n\n");
+
+  /* April start, labelled by start year */
+  memset(&def, 0, sizeof(def));
+  def.pattern = FASTKST_FISCAL_MONTHLY;
+  def.start_month = 4;
+  cal = fastkst_fiscal_compile(&def, 1900, 2200);
+  expect(cal, 2025, 4, 1, 2025, 1, 1, 1);
+  expect(cal, 2026, 3, 31, 2025, 4, 12, 53);
+  expect(cal, 2025, 10, 15, 2025, 3, 7, 29);
+
+  /* Brute force against fastkst_localtime() */
+  {
+    int bad = 0;
+    for (day = fastkst_days_from_civil(1901, 1, 1); day < fastkst_days_from_civil(2199, 1, 1); day += 3) {
+      time_t t = (time_t)(day * SECS_PER_DAY - KST_OFFSET + (day & 0xffff) % SECS_PER_DAY);
+      struct tm tm;
+      int fy, per;
+
+      fastkst_localtime(t, &tm);
+      fy = tm.tm_year + 1900 - (tm.tm_mon + 1 < 4);
+      per = (tm.tm_mon + 1 - 4 + 12) % 12 + 1;
+      if (!fastkst_fiscal_lookup(cal, t, &f) || f.year != fy || f.period != per ||
+          f.quarter != (per - 1) / 3 + 1 || f.day_of_period != tm.tm_mday)
+        bad++;
+    }
+    if (bad) {
+      printf("[FAIL] monthly brute force: %d mismatches\n", bad);
+      failures++;
+    } else {
+      printf("[PASS] monthly brute force 1901..2198\n");
+    }
+  }
+  if (fastkst_fiscal_lookup(cal, kst_noon(1900, 1, 1), NULL) != 0 ||
+      fastkst_fiscal_lookup(cal, kst_noon(1800, 1, 1), &f) != 0 || errno != ERANGE) {
+    printf("[FAIL] out of range rejected\n");
+    failures++;
+  }
+  fastkst_fiscal_free(cal);
+
+  /* NRF 4-5-4: week ends Saturday nearest to January 31 */
+  memset(&def, 0, sizeof(def));
+  def.pattern = FASTKST_FISCAL_454;
+  def.start_month = 2;
+  def.week_end_wday = 6;
+  def.year_end = FASTKST_FISCAL_END_NEAREST;
+  def.leap_week_period = 12;
+  cal = fastkst_fiscal_compile(&def, 2000, 2100);
+  expect(cal, 2023, 1, 29, 2023, 1, 1, 1);      /* FY2023 starts Sunday 2023-01-29 */
+  expect(cal, 2023, 2, 26, 2023, 1, 2, 5);      /* period 2 after 4 weeks */
+  expect(cal, 2023, 4, 2, 2023, 1, 3, 10);      /* period 3 after 4 + 5 weeks */
+  expect(cal, 2024, 2, 3, 2023, 4, 12, 53);     /* 53-week year */
+  expect(cal, 2024, 2, 4, 2024, 1, 1, 1);
+  expect(cal, 2025, 2, 1, 2024, 4, 12, 52);     /* 52-week year */
+
+  /* Every retail year is 52 or 53 whole weeks and starts the day after a Saturday */
+  {
+    int bad = 0, y;
+    for (y = 2000; y <= 2100; y++) {
+      time_t s0, s1;
+      fastkst_fiscal_period_start(cal, y, 1, &s0);
+      fastkst_fiscal_period_start(cal, y, 13, &s1);
+      if ((s1 - s0) != 364 * 86400 && (s1 - s0) != 371 * 86400)
+        bad++;
+      if (weekday_of(fastkst_floor_div(s0 + KST_OFFSET, SECS_PER_DAY)) != 0)
+        bad++;
+    }
+    if (bad) {
+      printf("[FAIL] retail year shapes: %d\n", bad);
+      failures++;
+    } else {
+      printf("[PASS] retail years are 52/53 weeks starting on Sunday\n");
+    }
+  }
+
+  /* Batch */
+  {
+    time_t ts[3] = { kst_noon(2023, 1, 29), kst_noon(2024, 2, 4), kst_noon(1990, 1, 1) };
+    fastkst_fiscal_t out[3];
+    if (fastkst_fiscal_lookup_batch(cal, ts, 3, out) != 2 || out[1].year != 2024) {
+      printf("[FAIL] batch lookup\n");
+      failures++;
+    } else {
+      printf("[PASS] batch lookup stops at the first out-of-range row\n");
+    }
+  }
+  fastkst_fiscal_free(cal);
+
+  /* Label by end year: FY2026 = 2025-07-01 .. 2026-06-30 */
+  memset(&def, 0, sizeof(def));
+  def.pattern = FASTKST_FISCAL_MONTHLY;
+  def.start_month = 7;
+  def.label_by_end = 1;
+  cal = fastkst_fiscal_compile(&def, 2020, 2030);
+  expect(cal, 2025, 7, 1, 2026, 1, 1, 1);
+  expect(cal, 2026, 6, 30, 2026, 4, 12, 53);
+  if (!fastkst_fiscal_period_start(cal, 2026, 1, &start) || start != kst_noon(2025, 7, 1) - 12 * 3600) {
+    printf("[FAIL] period start\n");
+    failures++;
+  }
+  fastkst_fiscal_free(cal);
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All fiscal tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d fiscal test(s) failed!\n", failures);
+  return 1;
+}
+#endif
@@ -0,0 +1,127 @@
+/**
+ * @file fastkst_fiscal.h
+ * @brief Fiscal / retail calendars (custom year start, 4-4-5, 52/53-week) over KST
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - A definition is compiled once into a table of period start days
+ *    (12 per fiscal year, contiguous), after which a lookup is the KST epoch
+ *    day of the timestamp plus two guessed-and-corrected table probes.
+ *  - Monthly calendars: periods are calendar months from start_month.
+ *  - Retail calendars: the year ends on week_end_wday, either the last one in
+ *    the month before start_month or the one nearest to that month's end;
+ *    periods follow the 4-4-5 / 4-5-4 / 5-4-4 week pattern and a 53-week
+ *    year gives its extra week to leap_week_period.
+ */
+
+#ifndef FASTKST_FISCAL_H
+#define FASTKST_FISCAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Period layout of a fiscal year
+ */
+typedef enum {
+  FASTKST_FISCAL_MONTHLY = 0,   /**< calendar months */
+  FASTKST_FISCAL_445     = 1,   /**< 4-4-5 weeks per quarter */
+  FASTKST_FISCAL_454     = 2,   /**< 4-5-4 weeks per quarter (NRF) */
+  FASTKST_FISCAL_544     = 3    /**< 5-4-4 weeks per quarter */
+} fastkst_fiscal_pattern_t;
+
+/**
+ * @brief How a retail year end is chosen
+ */
+typedef enum {
+  FASTKST_FISCAL_END_LAST    = 0,   /**< last week_end_wday of the month */
+  FASTKST_FISCAL_END_NEAREST = 1    /**< week_end_wday nearest to the month end */
+} fastkst_fiscal_end_t;
+
+/**
+ * @brief Fiscal calendar definition
+ */
+typedef struct {
+  fastkst_fiscal_pattern_t pattern;
+  int start_month;            /**< 1..12, month the fiscal year starts in */
+  int label_by_end;           /**< 0: FY named by the calendar year it starts in,
+                                   1: by the calendar year it ends in */
+  int week_end_wday;          /**< retail: tm_wday ending each week (6 = Saturday) */
+  fastkst_fiscal_end_t year_end;  /**< retail: year end rule */
+  int leap_week_period;       /**< retail: 1..12, period of the 53rd week (usually 12) */
+} fastkst_fiscal_def_t;
+
+/**
+ * @brief Fiscal position of a day
+ */
+typedef struct {
+  int32_t year;               /**< fiscal year label */
+  int8_t quarter;             /**< 1..4 */
+  int8_t period;              /**< 1..12 */
+  int8_t week;                /**< 1..53, week of the fiscal year */
+  int8_t week_of_period;      /**< 1..6 */
+  int16_t day_of_year;        /**< 1..371 */
+  int16_t day_of_period;      /**< 1..35 */
+} fastkst_fiscal_t;
+
+typedef struct fastkst_fiscal_cal fastkst_fiscal_cal_t;
+
+/**
+ * @brief Compile a definition for a range of fiscal years
+ * @param[in] def definition
+ * @param[in] first_year first fiscal year label covered
+ * @param[in] last_year last fiscal year label covered
+ * @return fastkst_fiscal_cal_t* compiled calendar, NULL on failure (errno set)
+ */
+fastkst_fiscal_cal_t *fastkst_fiscal_compile(const fastkst_fiscal_def_t *def,
+                                             int first_year, int last_year);
+
+/**
+ * @brief Free a compiled calendar
+ */
+void fastkst_fiscal_free(fastkst_fiscal_cal_t *cal);
+
+/**
+ * @brief Fiscal position of the KST day containing t
+ * @return int 1 on success, 0 on failure
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer)
+ *       - ERANGE: t is outside the compiled years
+ */
+int fastkst_fiscal_lookup(const fastkst_fiscal_cal_t *cal, time_t t,
+                          fastkst_fiscal_t *out);
+
+/**
+ * @brief Batch version of fastkst_fiscal_lookup()
+ * @return size_t number of elements converted; less than n on failure
+ */
+size_t fastkst_fiscal_lookup_batch(const fastkst_fiscal_cal_t *cal,
+                                   const time_t *t, size_t n,
+                                   fastkst_fiscal_t *out);
+
+/**
+ * @brief First second (UTC epoch) of a fiscal period
+ * @param[in] cal compiled calendar
+ * @param[in] year fiscal year label
+ * @param[in] period 1..12, or 13 for the start of the following year
+ * @param[out] start start of the period
+ * @return int 1 on success, 0 on failure (EINVAL, ERANGE)
+ */
+int fastkst_fiscal_period_start(const fastkst_fiscal_cal_t *cal, int year,
+                                int period, time_t *start);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_FISCAL_H */
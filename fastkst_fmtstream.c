@@ -0,0 +1,241 @@
+/**
+ * @file fastkst_fmtstream.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Incremental KST text formatting of sorted timestamp streams
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Test code: enabled with TEST_FASTKST_FMTSTREAM
+ */
+#include <time.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include "fastkst_fmtstream.h"
+#include "fastkst_internal.h"
+
+#define POS_HOUR  11
+#define POS_MIN   14
+#define POS_SEC   17
+
+void fastkst_fmtstream_init(fastkst_fmtstream_t *st)
+{
+  if (st == NULL)
+    return;
+  memset(st, 0, sizeof(*st));
+}
+
+static int render_full(fastkst_fmtstream_t *st, int64_t t)
+{
+  struct tm tm;
+
+  if (__offtime64((time_t)t, KST_OFFSET, &tm) != 1)
+    return 0;
+  fastkst_put_datetime(st->text, &tm);
+  st->text[FASTKST_FMTSTREAM_WIDTH] = '\0';
+  st->hour = tm.tm_hour;
+  st->min = tm.tm_min;
+  st->sec = tm.tm_sec;
+  st->day_start = t - (tm.tm_hour * SECS_PER_HOUR + tm.tm_min * 60 + tm.tm_sec);
+  st->valid = 1;
+  st->full_renders++;
+  return 1;
+}
+
+/* Same day, earlier second: rewrite H:M:S from the second of day */
+static inline void render_hms(fastkst_fmtstream_t *st, int sod)
+{
+  st->hour = sod / SECS_PER_HOUR;
+  st->min = sod / 60 % 60;
+  st->sec = sod % 60;
+  fastkst_put2(st->text + POS_HOUR, (unsigned)st->hour);
+  fastkst_put2(st->text + POS_MIN, (unsigned)st->min);
+  fastkst_put2(st->text + POS_SEC, (unsigned)st->sec);
+}
+
+/* Same day, delta > 0 seconds later: add to seconds and carry upwards */
+static inline void carry_add(fastkst_fmtstream_t *st, int delta)
+{
+  char *p = st->text;
+  int s = st->sec + delta;
+  int m;
+
+  if (s < 60) {
+    if (s / 10 != st->sec / 10)
+      p[POS_SEC] = (char)('0' + s / 10);
+    p[POS_SEC + 1] = (char)('0' + s % 10);
+    st->sec = s;
+    return;
+  }
+  st->sec = s % 60;
+  fastkst_put2(p + POS_SEC, (unsigned)st->sec);
+
+  m = st->min + s / 60;
+  if (m < 60) {
+    st->min = m;
+    fastkst_put2(p + POS_MIN, (unsigned)m);
+    return;
+  }
+  st->min = m % 60;
+  fastkst_put2(p + POS_MIN, (unsigned)st->min);
+
+  /* the caller guarantees the day does not change */
+  st->hour += m / 60;
+  fastkst_put2(p + POS_HOUR, (unsigned)st->hour);
+}
+
+static inline int advance(fastkst_fmtstream_t *st, int64_t t)
+{
+  if (st->valid && t >= st->day_start && t - st->day_start < SECS_PER_DAY) {
+    if (t > st->last)
+      carry_add(st, (int)(t - st->last));
+    else if (t < st->last)
+      render_hms(st, (int)(t - st->day_start));
+  } else if (!render_full(st, t)) {
+    return 0;
+  }
+  st->last = t;
+  return 1;
+}
+
+const char *fastkst_fmtstream_next(fastkst_fmtstream_t *st, time_t t)
+{
+  if (st == NULL) {
+    errno = EINVAL;
+    return NULL;
+  }
+  return advance(st, t) ? st->text : NULL;
+}
+
+size_t fastkst_fmtstream_format(fastkst_fmtstream_t *st, const time_t *t, size_t n,
+                                char *buf, size_t stride)
+{
+  size_t i;
+
+  if (st == NULL || (n > 0 && (t == NULL || buf == NULL)) ||
+      stride < FASTKST_FMTSTREAM_WIDTH) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (!advance(st, t[i]))
+      return i;
+    memcpy(buf + i * stride, st->text, FASTKST_FMTSTREAM_WIDTH);
+  }
+  return n;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_FMTSTREAM
+/* 빌드 방법
+gcc -DTEST_FASTKST_FMTSTREAM -o fastkst_fmtstream_test fastkst_fmtstream.c fastkst_localtime.c
+./fastkst_fmtstream_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+  enum { N = 1 << 20, STRIDE = 20 };
+  fastkst_fmtstream_t st;
+  time_t *ts = malloc(N * sizeof(time_t));
+  char *buf = malloc((size_t)N * STRIDE);
+  char *ref = malloc((size_t)N * STRIDE);
+  const char *s;
+  double t0, t1, t2;
+  size_t i;
+  int bad;
+
+  printf("=== FASTKST_FMTSTREAM Test ===\n\n");
+
+  fastkst_fmtstream_init(&st);
+  s = fastkst_fmtstream_next(&st, 1767193199);     /* 2025-12-31 23:59:59 KST */
+  CHECK(s && strcmp(s, "2025-12-31 23:59:59") == 0, "first render");
+  s = fastkst_fmtstream_next(&st, 1767193200);
+  CHECK(s && strcmp(s, "2026-01-01 00:00:00") == 0 && st.full_renders == 2,
+        "new day re-renders");
+  s = fastkst_fmtstream_next(&st, 1767193200 + 3599);
+  CHECK(s && strcmp(s, "2026-01-01 00:59:59") == 0, "carry into minutes");
+  s = fastkst_fmtstream_next(&st, 1767193200 + 3600);
+  CHECK(s && strcmp(s, "2026-01-01 01:00:00") == 0, "carry into hours");
+  s = fastkst_fmtstream_next(&st, 1767193200 + 59);
+  CHECK(s && strcmp(s, "2026-01-01 00:00:59") == 0 && st.full_renders == 2,
+        "step back within the day");
+
+  /* Mostly sorted stream: small steps, occasional jumps and steps back */
+  srand(85);
+  ts[0] = -86400 * 3;
+  for (i = 1; i < N; i++) {
+    int r = rand() % 1000;
+    if (r == 0)
+      ts[i] = ts[i - 1] + rand() % (40 * 86400);
+    else if (r == 1)
+      ts[i] = ts[i - 1] - rand() % 100;
+    else if (r < 50)
+      ts[i] = ts[i - 1] + rand() % 4000;
+    else
+      ts[i] = ts[i - 1] + rand() % 3;
+  }
+  memset(buf, '\n', (size_t)N * STRIDE);
+  memset(ref, '\n', (size_t)N * STRIDE);
+
+  t0 = now_sec();
+  for (i = 0; i < N; i++) {
+    struct tm tm;
+    char tmp[32];
+    fastkst_localtime(ts[i], &tm);
+    strftime(tmp, sizeof(tmp), "%Y-%m-%d %H:%M:%S", &tm);
+    memcpy(ref + i * STRIDE, tmp, 19);
+  }
+  t1 = now_sec();
+  fastkst_fmtstream_init(&st);
+  CHECK(fastkst_fmtstream_format(&st, ts, N, buf, STRIDE) == N, "format all rows");
+  t2 = now_sec();
+
+  bad = memcmp(buf, ref, (size_t)N * STRIDE) != 0;
+  CHECK(bad == 0, "matches fastkst_localtime() + strftime() row for row");
+  printf("  %d rows: localtime+strftime %.1f ms, stream %.1f ms (%llu full renders)\n",
+         N, (t1 - t0) * 1e3, (t2 - t1) * 1e3, (unsigned long long)st.full_renders);
+
+  CHECK(fastkst_fmtstream_format(&st, ts, 1, buf, 18) == 0 && errno == EINVAL,
+        "short stride rejected");
+
+  free(ts);
+  free(buf);
+  free(ref);
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All fmtstream tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d fmtstream test(s) failed!\n", failures);
+  return 1;
+}
+#endif
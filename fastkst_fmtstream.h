@@ -0,0 +1,76 @@
+/**
+ * @file fastkst_fmtstream.h
+ * @brief Incremental KST text formatting of sorted timestamp streams
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Keeps the last rendered "YYYY-MM-DD HH:MM:SS" and its H:M:S fields.
+ *    A later timestamp on the same KST day is applied by adding the
+ *    difference to the seconds field and carrying into minutes and hours,
+ *    rewriting only the fields that changed (usually the last one or two
+ *    digits).
+ *  - Moving to another day, or backwards, re-renders: through __offtime64()
+ *    for a new day, from the second of day for a step back within the day.
+ */
+
+#ifndef FASTKST_FMTSTREAM_H
+#define FASTKST_FMTSTREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FASTKST_FMTSTREAM_WIDTH   19    /**< strlen("YYYY-MM-DD HH:MM:SS") */
+
+/**
+ * @brief Stream state (one per output stream, not shared between threads)
+ */
+typedef struct {
+  char text[FASTKST_FMTSTREAM_WIDTH + 1];   /**< last rendered text, NUL terminated */
+  int64_t last;               /**< last timestamp */
+  int64_t day_start;          /**< UTC epoch second of the KST midnight of last */
+  int hour, min, sec;         /**< fields of last */
+  int valid;                  /**< 0 until the first timestamp */
+  uint64_t full_renders;      /**< statistics: number of __offtime64() renders */
+} fastkst_fmtstream_t;
+
+/**
+ * @brief Initialise (or reset) a stream
+ */
+void fastkst_fmtstream_init(fastkst_fmtstream_t *st);
+
+/**
+ * @brief Render the next timestamp
+ * @param[in,out] st stream state
+ * @param[in] t timestamp
+ * @return const char* st->text, NULL on failure (EINVAL, EOVERFLOW)
+ */
+const char *fastkst_fmtstream_next(fastkst_fmtstream_t *st, time_t t);
+
+/**
+ * @brief Render a run of timestamps into a fixed-width buffer
+ * @param[in,out] st stream state (continues from the previous call)
+ * @param[in] t timestamps, ideally sorted
+ * @param[in] n number of timestamps
+ * @param[out] buf row i starts at buf + i * stride
+ * @param[in] stride bytes per row, at least FASTKST_FMTSTREAM_WIDTH; the
+ *            text is not NUL terminated and bytes past it are left as they
+ *            are (pre-filled separators or other columns)
+ * @return size_t number of rows written; less than n on failure
+ */
+size_t fastkst_fmtstream_format(fastkst_fmtstream_t *st, const time_t *t, size_t n,
+                                char *buf, size_t stride);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_FMTSTREAM_H */
@@ -0,0 +1,122 @@
+/**
+ * @file fastkst_internal.h
+ * @brief Internal helpers shared by the fastkst_* modules
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note Not installed. Everything here assumes the fixed KST (UTC+9) offset
+ *       and is meant to be included only by the library's own sources.
+ */
+
+#ifndef FASTKST_INTERNAL_H
+#define FASTKST_INTERNAL_H
+
+#include <time.h>
+#include <stdint.h>
+
+#define __isleap(year)        \
+  ((year) % 4 == 0 && ((year) % 100 != 0 || (year) % 400 == 0))
+
+#define SECS_PER_HOUR   (60 * 60)
+#define SECS_PER_DAY    (SECS_PER_HOUR * 24)
+
+/* KST offset: UTC+9 */
+#define KST_OFFSET      (9 * SECS_PER_HOUR)
+
+extern const unsigned short int __mon_yday[2][13];
+
+int __offtime64(time_t t, long int offset, struct tm *tp);
+
+/**
+ * @brief Floor division (rounds toward negative infinity)
+ */
+static inline int64_t fastkst_floor_div(int64_t a, int64_t b)
+{
+  int64_t q = a / b;
+  return q - ((a % b != 0) & ((a < 0) != (b < 0)));
+}
+
+/**
+ * @brief Epoch day (1970-01-01 = 0) of a proleptic Gregorian date
+ * @param[in] y year
+ * @param[in] m month, 1..12
+ * @param[in] d day of month, 1..31
+ */
+static inline int64_t fastkst_days_from_civil(int64_t y, int m, int d)
+{
+  int64_t era, yoe, doy;
+
+  y -= m <= 2;
+  era = fastkst_floor_div(y, 400);
+  yoe = y - era * 400;                                     /* [0, 399] */
+  doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;     /* [0, 365] */
+  return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+}
+
+/**
+ * @brief Proleptic Gregorian date of an epoch day (inverse of fastkst_days_from_civil)
+ * @param[in] z epoch day
+ * @param[out] y year
+ * @param[out] m month, 1..12
+ * @param[out] d day of month, 1..31
+ */
+static inline void fastkst_civil_from_days(int64_t z, int64_t *y, int *m, int *d)
+{
+  int64_t era, doe, yoe, doy, mp;
+
+  z += 719468;
+  era = fastkst_floor_div(z, 146097);
+  doe = z - era * 146097;                                          /* [0, 146096] */
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;     /* [0, 399] */
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                   /* [0, 365] */
+  mp = (5 * doy + 2) / 153;                                        /* [0, 11] */
+  *d = (int)(doy - (153 * mp + 2) / 5 + 1);
+  *m = (int)(mp < 10 ? mp + 3 : mp - 9);
+  *y = yoe + era * 400 + (*m <= 2);
+}
+
+/**
+ * @brief Write v (0..99) as two ASCII digits
+ */
+static inline void fastkst_put2(char *p, unsigned v)
+{
+  p[0] = (char)('0' + v / 10);
+  p[1] = (char)('0' + v % 10);
+}
+
+/**
+ * @brief Write "YYYY-MM-DD HH:MM:SS" (19 bytes, no NUL) from a struct tm
+ * @note Years outside 0..9999 are written modulo 10000.
+ */
+static inline void fastkst_put_datetime(char *p, const struct tm *tp)
+{
+  unsigned y = (unsigned)(tp->tm_year + 1900) % 10000;
+
+  fastkst_put2(p, y / 100);
+  fastkst_put2(p + 2, y % 100);
+  p[4] = '-';
+  fastkst_put2(p + 5, (unsigned)tp->tm_mon + 1);
+  p[7] = '-';
+  fastkst_put2(p + 8, (unsigned)tp->tm_mday);
+  p[10] = ' ';
+  fastkst_put2(p + 11, (unsigned)tp->tm_hour);
+  p[13] = ':';
+  fastkst_put2(p + 14, (unsigned)tp->tm_min);
+  p[16] = ':';
+  fastkst_put2(p + 17, (unsigned)tp->tm_sec);
+}
+
+/**
+ * @brief Fill the timezone fields the way fastkst_localtime() does
+ */
+static inline void fastkst_set_zone(struct tm *tp)
+{
+  tp->tm_gmtoff = KST_OFFSET;
+  tp->tm_zone = "KST";
+  tp->tm_isdst = 0;
+}
+
+#endif /* FASTKST_INTERNAL_H */
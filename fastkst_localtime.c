@@ -23,8 +23,7 @@
 #include <limits.h>
 #include <string.h>
 
-#define __isleap(year)        \
-  ((year) % 4 == 0 && ((year) % 100 != 0 || (year) % 400 == 0))
+#include "fastkst_internal.h"
 
 const unsigned short int __mon_yday[2][13] =
   {
@@ -34,9 +33,6 @@ const unsigned short int __mon_yday[2][13] =
     { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366 }
   };
 
-#define SECS_PER_HOUR   (60 * 60)
-#define SECS_PER_DAY    (SECS_PER_HOUR * 24)
-
 /**
  * @brief 64-bit safe time conversion function
  * @param[in] t time_t (supports 64-bit)
@@ -0,0 +1,288 @@
+/**
+ * @file fastkst_multizone.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief One timestamp broken down in several fixed-offset zones at once
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Test code: enabled with TEST_FASTKST_MULTIZONE
+ */
+#include <time.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+
+#include "fastkst_multizone.h"
+#include "fastkst_internal.h"
+
+static int check_zones(const fastkst_zone_t *zones, size_t nzones)
+{
+  size_t z;
+
+  for (z = 0; z < nzones; z++) {
+    if (zones[z].offset <= -SECS_PER_DAY || zones[z].offset >= SECS_PER_DAY)
+      return 0;
+  }
+  return 1;
+}
+
+/* Move a broken-down date (H:M:S untouched) to the next day */
+static inline int next_day(struct tm *tp)
+{
+  const unsigned short int *ip = __mon_yday[__isleap(tp->tm_year + 1900LL)];
+
+  tp->tm_wday = tp->tm_wday == 6 ? 0 : tp->tm_wday + 1;
+  tp->tm_yday++;
+  if (++tp->tm_mday > ip[tp->tm_mon + 1] - ip[tp->tm_mon]) {
+    tp->tm_mday = 1;
+    if (++tp->tm_mon == 12) {
+      if (tp->tm_year == INT_MAX)
+        return 0;
+      tp->tm_mon = 0;
+      tp->tm_year++;
+      tp->tm_yday = 0;
+    }
+  }
+  return 1;
+}
+
+/* Move a broken-down date (H:M:S untouched) to the previous day */
+static inline int prev_day(struct tm *tp)
+{
+  const unsigned short int *ip;
+
+  tp->tm_wday = tp->tm_wday == 0 ? 6 : tp->tm_wday - 1;
+  tp->tm_yday--;
+  if (--tp->tm_mday == 0) {
+    if (--tp->tm_mon < 0) {
+      if (tp->tm_year == INT_MIN)
+        return 0;
+      tp->tm_mon = 11;
+      tp->tm_year--;
+    }
+    ip = __mon_yday[__isleap(tp->tm_year + 1900LL)];
+    tp->tm_mday = ip[tp->tm_mon + 1] - ip[tp->tm_mon];
+    tp->tm_yday = ip[tp->tm_mon + 1] - 1;
+  }
+  return 1;
+}
+
+/* Fill out[0..nzones) from the decomposed UTC day and the second of that day */
+static int fan_out(const struct tm *utc_day, int64_t rem,
+                   const fastkst_zone_t *zones, size_t nzones, struct tm *out)
+{
+  size_t z;
+
+  for (z = 0; z < nzones; z++) {
+    struct tm *tp = &out[z];
+    int64_t r = rem + zones[z].offset;
+
+    *tp = *utc_day;
+    if (r < 0) {
+      r += SECS_PER_DAY;
+      if (!prev_day(tp))
+        goto overflow;
+    } else if (r >= SECS_PER_DAY) {
+      r -= SECS_PER_DAY;
+      if (!next_day(tp))
+        goto overflow;
+    }
+    tp->tm_hour = (int)(r / SECS_PER_HOUR);
+    r %= SECS_PER_HOUR;
+    tp->tm_min = (int)(r / 60);
+    tp->tm_sec = (int)(r % 60);
+    tp->tm_gmtoff = zones[z].offset;
+    tp->tm_zone = zones[z].name;
+    tp->tm_isdst = 0;
+  }
+  return 1;
+
+overflow:
+  errno = EOVERFLOW;
+  return 0;
+}
+
+int fastkst_offtime_multi(time_t t, const fastkst_zone_t *zones, size_t nzones,
+                          struct tm *out)
+{
+  struct tm utc;
+  int64_t rem;
+
+  if ((nzones > 0 && (zones == NULL || out == NULL)) || !check_zones(zones, nzones)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (__offtime64(t, 0, &utc) != 1)
+    return 0;
+  rem = (int64_t)utc.tm_hour * SECS_PER_HOUR + utc.tm_min * 60 + utc.tm_sec;
+  return fan_out(&utc, rem, zones, nzones, out);
+}
+
+size_t fastkst_offtime_multi_batch(const time_t *t, size_t n,
+                                   const fastkst_zone_t *zones, size_t nzones,
+                                   struct tm *out)
+{
+  struct tm utc;
+  int64_t day_start = 0;
+  int valid = 0;
+  size_t i;
+
+  if ((n > 0 && t == NULL) || (n > 0 && nzones > 0 && out == NULL) ||
+      (nzones > 0 && zones == NULL) || !check_zones(zones, nzones)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    int64_t rem = (int64_t)t[i] - day_start;
+
+    if (!valid || rem < 0 || rem >= SECS_PER_DAY) {
+      if (__offtime64(t[i], 0, &utc) != 1)
+        return i;
+      rem = (int64_t)utc.tm_hour * SECS_PER_HOUR + utc.tm_min * 60 + utc.tm_sec;
+      day_start = (int64_t)t[i] - rem;
+      valid = 1;
+    }
+    if (!fan_out(&utc, rem, zones, nzones, out + i * nzones))
+      return i;
+  }
+  return n;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_MULTIZONE
+/* 빌드 방법
+gcc -DTEST_FASTKST_MULTIZONE -o fastkst_multizone_test fastkst_multizone.c fastkst_localtime.c
+./fastkst_multizone_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static int same_tm(const struct tm *a, const struct tm *b)
+{
+  return a->tm_year == b->tm_year && a->tm_mon == b->tm_mon &&
+         a->tm_mday == b->tm_mday && a->tm_hour == b->tm_hour &&
+         a->tm_min == b->tm_min && a->tm_sec == b->tm_sec &&
+         a->tm_wday == b->tm_wday && a->tm_yday == b->tm_yday;
+}
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+  static const fastkst_zone_t zones[] = {
+    { 9 * 3600, "KST" }, { 0, "UTC" }, { 9 * 3600, "JST" },
+    { -12 * 3600, "-12" }, { 14 * 3600, "+14" },
+    { -(SECS_PER_DAY - 1), "min" }, { SECS_PER_DAY - 1, "max" },
+    { 5 * 3600 + 45 * 60, "NPT" }, { -(3 * 3600 + 30 * 60), "NST" }
+  };
+  const size_t nz = sizeof(zones) / sizeof(zones[0]);
+  struct tm out[sizeof(zones) / sizeof(zones[0])];
+  struct tm ref;
+  size_t z;
+  int i, bad;
+
+  printf("=== FASTKST_MULTIZONE Test ===\n\n");
+
+  /* 2025-12-31 15:00:00 UTC = 2026-01-01 00:00:00 KST */
+  CHECK(fastkst_offtime_multi(1767193200, zones, 3, out) &&
+        out[0].tm_year == 126 && out[0].tm_yday == 0 && out[0].tm_hour == 0 &&
+        out[1].tm_year == 125 && out[1].tm_mon == 11 && out[1].tm_mday == 31 &&
+        out[1].tm_hour == 15 && strcmp(out[2].tm_zone, "JST") == 0 &&
+        out[0].tm_gmtoff == 9 * 3600, "KST/UTC/JST across new year");
+
+  /* Against __offtime64() per zone: random, year/month/leap edges, negative t */
+  bad = 0;
+  srand(83);
+  for (i = 0; i < 400000; i++) {
+    time_t t;
+
+    if (i & 1)
+      t = (time_t)(((int64_t)rand() << 20) ^ rand()) - ((int64_t)1 << 50);
+    else
+      t = (time_t)(fastkst_days_from_civil(1900 + rand() % 300, 1 + rand() % 12, 1) * SECS_PER_DAY
+                   + rand() % (2 * SECS_PER_DAY) - SECS_PER_DAY);
+
+    if (!fastkst_offtime_multi(t, zones, nz, out)) {
+      bad++;
+      continue;
+    }
+    for (z = 0; z < nz; z++) {
+      if (__offtime64(t, zones[z].offset, &ref) != 1 || !same_tm(&out[z], &ref))
+        bad++;
+    }
+  }
+  CHECK(bad == 0, "matches __offtime64() for every zone");
+
+  {
+    static const fastkst_zone_t bad_zone[] = { { SECS_PER_DAY, "bad" } };
+    CHECK(fastkst_offtime_multi(0, bad_zone, 1, out) == 0 && errno == EINVAL,
+          "offset of a full day rejected");
+  }
+
+  /* Batch against the scalar form, with a speed comparison */
+  {
+    enum { N = 1 << 18, NZ = 3 };
+    time_t *ts = malloc(N * sizeof(time_t));
+    struct tm *multi = malloc((size_t)N * NZ * sizeof(struct tm));
+    struct tm *each = malloc((size_t)N * NZ * sizeof(struct tm));
+    double t0, t1, t2;
+    size_t k;
+
+    for (k = 0; k < N; k++)
+      ts[k] = 1767193200 - 3 * SECS_PER_DAY + (time_t)(k * 3);
+    /* fault the outputs in before timing */
+    memset(multi, 0, (size_t)N * NZ * sizeof(struct tm));
+    memset(each, 0, (size_t)N * NZ * sizeof(struct tm));
+
+    t0 = now_sec();
+    for (k = 0; k < N; k++)
+      for (z = 0; z < NZ; z++)
+        __offtime64(ts[k], zones[z].offset, &each[k * NZ + z]);
+    t1 = now_sec();
+    CHECK(fastkst_offtime_multi_batch(ts, N, zones, NZ, multi) == N, "batch converts all rows");
+    t2 = now_sec();
+
+    bad = 0;
+    for (k = 0; k < (size_t)N * NZ; k++)
+      bad += !same_tm(&multi[k], &each[k]);
+    CHECK(bad == 0, "batch matches per-zone __offtime64()");
+    printf("  %d x %d zones: __offtime64 %.1f ms, batch %.1f ms\n",
+           N, NZ, (t1 - t0) * 1e3, (t2 - t1) * 1e3);
+
+    free(ts);
+    free(multi);
+    free(each);
+  }
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All multizone tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d multizone test(s) failed!\n", failures);
+  return 1;
+}
+#endif
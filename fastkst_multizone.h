@@ -0,0 +1,70 @@
+/**
+ * @file fastkst_multizone.h
+ * @brief One timestamp broken down in several fixed-offset zones at once
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - The UTC day of the timestamp is decomposed once with __offtime64();
+ *    each zone then only recomputes H:M:S and, when its offset moves it to
+ *    the previous or next day, steps the date by one using __mon_yday.
+ *  - Offsets must be strictly within one day (|offset| < 86400), which
+ *    covers every real zone (-12:00 .. +14:00).
+ */
+
+#ifndef FASTKST_MULTIZONE_H
+#define FASTKST_MULTIZONE_H
+
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fixed-offset zone
+ */
+typedef struct {
+  long int offset;            /**< seconds east of UTC, e.g. 9 * 3600 for KST */
+  const char *name;           /**< stored in tm_zone (e.g. "KST"), can be NULL */
+} fastkst_zone_t;
+
+/**
+ * @brief Convert one timestamp to several zones
+ * @param[in] t time_t
+ * @param[in] zones zones to convert to
+ * @param[in] nzones number of zones
+ * @param[out] out nzones results, in the order of zones
+ * @return int 1 on success, 0 on failure
+ *
+ * @note Error codes:
+ *       - EINVAL: Invalid argument (NULL pointer, offset out of range)
+ *       - EOVERFLOW: Year exceeds struct tm range
+ */
+int fastkst_offtime_multi(time_t t, const fastkst_zone_t *zones, size_t nzones,
+                          struct tm *out);
+
+/**
+ * @brief Batch version of fastkst_offtime_multi()
+ * @param[in] t timestamps
+ * @param[in] n number of timestamps
+ * @param[in] zones zones to convert to
+ * @param[in] nzones number of zones
+ * @param[out] out n * nzones results; row i holds out[i * nzones .. i * nzones + nzones)
+ * @return size_t number of timestamps converted; less than n on failure
+ *
+ * @note Consecutive timestamps on the same UTC day reuse its decomposition.
+ */
+size_t fastkst_offtime_multi_batch(const time_t *t, size_t n,
+                                   const fastkst_zone_t *zones, size_t nzones,
+                                   struct tm *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_MULTIZONE_H */
@@ -0,0 +1,800 @@
+/**
+ * @file fastkst_parse.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Fixed-layout log timestamp parsers (CLF, RFC 3164, HTTP-date, RFC 2822,
+ *        ISO 8601)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Names: the three letters, folded to lower case, form a 24-bit key;
+ *    key * M >> (32 - bits) is collision free for the 12 months (16 slots)
+ *    and the 7 weekdays (8 slots), and the slot's key is compared to reject
+ *    anything else.
+ *  - HH:MM:SS: the 8 bytes are validated and converted as one 64-bit word
+ *    (digit pairs combined with d * 10 + (d >> 8)).
+ *  - Test code: enabled with TEST_FASTKST_PARSE
+ */
+#define _GNU_SOURCE
+#include <time.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include "fastkst_parse.h"
+#include "fastkst_internal.h"
+
+#define NAME3(a, b, c)  (((uint32_t)(a) << 16) | ((uint32_t)(b) << 8) | (uint32_t)(c))
+#define MONTH_HASH(k)   (((uint32_t)(k) * 0x2C4A3699u) >> 28)
+#define WDAY_HASH(k)    (((uint32_t)(k) * 0x8C7E134Fu) >> 29)
+
+struct name_slot {
+  uint32_t key;
+  int8_t value;
+};
+
+static const struct name_slot month_slots[16] = {
+  [12] = { NAME3('j', 'a', 'n'), 0 },  [15] = { NAME3('f', 'e', 'b'), 1 },
+  [1]  = { NAME3('m', 'a', 'r'), 2 },  [14] = { NAME3('a', 'p', 'r'), 3 },
+  [4]  = { NAME3('m', 'a', 'y'), 4 },  [8]  = { NAME3('j', 'u', 'n'), 5 },
+  [3]  = { NAME3('j', 'u', 'l'), 6 },  [6]  = { NAME3('a', 'u', 'g'), 7 },
+  [2]  = { NAME3('s', 'e', 'p'), 8 },  [7]  = { NAME3('o', 'c', 't'), 9 },
+  [0]  = { NAME3('n', 'o', 'v'), 10 }, [11] = { NAME3('d', 'e', 'c'), 11 },
+};
+
+static const struct name_slot wday_slots[8] = {
+  [5] = { NAME3('s', 'u', 'n'), 0 }, [2] = { NAME3('m', 'o', 'n'), 1 },
+  [6] = { NAME3('t', 'u', 'e'), 2 }, [4] = { NAME3('w', 'e', 'd'), 3 },
+  [1] = { NAME3('t', 'h', 'u'), 4 }, [3] = { NAME3('f', 'r', 'i'), 5 },
+  [0] = { NAME3('s', 'a', 't'), 6 },
+};
+
+/* Lower-cased 3-letter key; only letters fold onto letters */
+static inline uint32_t name_key(const char *p)
+{
+  return NAME3((uint8_t)p[0], (uint8_t)p[1], (uint8_t)p[2]) | 0x202020u;
+}
+
+/* 0..11, -1 if not a month name */
+static inline int month_of(const char *p)
+{
+  uint32_t k = name_key(p);
+  const struct name_slot *e = &month_slots[MONTH_HASH(k)];
+  return e->key == k ? e->value : -1;
+}
+
+/* 0..6 (Sunday = 0), -1 if not a weekday name */
+static inline int wday_of(const char *p)
+{
+  uint32_t k = name_key(p);
+  const struct name_slot *e = &wday_slots[WDAY_HASH(k)];
+  return e->key == k ? e->value : -1;
+}
+
+static inline int is_digit(char c)
+{
+  return (unsigned)(c - '0') <= 9;
+}
+
+/* Two ASCII digits, -1 if either is not a digit */
+static inline int dig2(const char *p)
+{
+  if (!is_digit(p[0]) || !is_digit(p[1]))
+    return -1;
+  return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
+static inline int dig4(const char *p)
+{
+  int hi = dig2(p), lo = dig2(p + 2);
+  return (hi < 0 || lo < 0) ? -1 : hi * 100 + lo;
+}
+
+static inline uint64_t load_le64(const char *p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+#else
+  uint64_t v = 0;
+  int i;
+  for (i = 7; i >= 0; i--)
+    v = (v << 8) | (uint8_t)p[i];
+  return v;
+#endif
+}
+
+/* "HH:MM:SS" (8 bytes) to seconds of day, -1 if malformed; :60 is allowed */
+static inline int parse_hms(const char *p)
+{
+  const uint64_t digit_mask = 0xF0F000F0F000F0F0ull;
+  const uint64_t digit_high = 0x3030003030003030ull;
+  uint64_t x = load_le64(p);
+  uint64_t d;
+  unsigned h, m, s;
+
+  if ((x & 0x0000FF0000FF0000ull) != 0x00003A00003A0000ull ||
+      (x & digit_mask) != digit_high ||
+      ((x + 0x0606000606000606ull) & digit_mask) != digit_high)
+    return -1;
+
+  d = (x & 0xFFFF00FFFF00FFFFull) - digit_high;
+  d = d * 10 + (d >> 8);
+  h = (unsigned)(d & 0xFF);
+  m = (unsigned)((d >> 24) & 0xFF);
+  s = (unsigned)((d >> 48) & 0xFF);
+  if (h > 23 || m > 59 || s > 60)
+    return -1;
+  return (int)(h * 3600 + m * 60 + s);
+}
+
+/* "+hhmm" / "-hhmm" to seconds east of UTC; 0 on success */
+static inline int parse_numeric_zone(const char *p, long *offset)
+{
+  int hh, mm;
+
+  if (p[0] != '+' && p[0] != '-')
+    return -1;
+  hh = dig2(p + 1);
+  mm = dig2(p + 3);
+  if (hh < 0 || hh > 23 || mm < 0 || mm > 59)
+    return -1;
+  *offset = (hh * 3600L + mm * 60L) * (p[0] == '-' ? -1 : 1);
+  return 0;
+}
+
+static inline int valid_date(int64_t y, int mon, int mday)
+{
+  const unsigned short int *ip = __mon_yday[__isleap(y)];
+  return mday >= 1 && mday <= ip[mon + 1] - ip[mon];
+}
+
+static inline time_t make_epoch(int64_t y, int mon, int mday, int sod, long offset)
+{
+  return (time_t)(fastkst_days_from_civil(y, mon + 1, mday) * SECS_PER_DAY + sod - offset);
+}
+
+size_t fastkst_parse_clf(const char *s, size_t len, time_t *out)
+{
+  size_t b = 0;
+  int mday, mon, y, sod;
+  long off;
+
+  if (s == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (len > 0 && s[0] == '[')
+    b = 1;
+  if (len < b + 26 + b)
+    goto fail;
+  s += b;
+
+  /* 31/Dec/2025:12:52:45 +0900 */
+  mday = dig2(s);
+  mon = month_of(s + 3);
+  y = dig4(s + 7);
+  sod = parse_hms(s + 12);
+  if (mday < 0 || mon < 0 || y < 0 || sod < 0 ||
+      s[2] != '/' || s[6] != '/' || s[11] != ':' || s[20] != ' ' ||
+      parse_numeric_zone(s + 21, &off) != 0 || !valid_date(y, mon, mday) ||
+      (b && s[26] != ']'))
+    goto fail;
+
+  *out = make_epoch(y, mon, mday, sod, off);
+  return 26 + 2 * b;
+
+fail:
+  errno = EINVAL;
+  return 0;
+}
+
+/* Reference year = KST calendar year of ref */
+static int ref_year(time_t ref, int64_t *year)
+{
+  struct tm tm;
+
+  if (__offtime64(ref, KST_OFFSET, &tm) != 1)
+    return 0;
+  *year = (int64_t)tm.tm_year + 1900;
+  return 1;
+}
+
+/* Year closest to ref; or, with limit != NULL, the latest one not after *limit */
+static size_t parse_syslog_year(const char *s, size_t len, time_t ref, int64_t year,
+                                const int64_t *limit, time_t *out)
+{
+  int mon, mday, sod;
+  int64_t y, best_diff = INT64_MAX;
+
+  if (len < 15)
+    goto fail;
+
+  /* Dec 31 12:52:45, day space padded */
+  mon = month_of(s);
+  mday = s[4] == ' ' ? (is_digit(s[5]) ? s[5] - '0' : -1) : dig2(s + 4);
+  sod = parse_hms(s + 7);
+  if (mon < 0 || mday < 0 || sod < 0 || s[3] != ' ' || s[6] != ' ')
+    goto fail;
+
+  if (limit != NULL) {
+    /* Feb 29 may need up to 8 years back (2096 -> 2104) */
+    for (y = year + 1; y >= year - 8; y--) {
+      time_t t;
+
+      if (!valid_date(y, mon, mday))
+        continue;
+      t = make_epoch(y, mon, mday, sod, KST_OFFSET);
+      if ((int64_t)t <= *limit) {
+        *out = t;
+        return 15;
+      }
+    }
+    goto fail;
+  }
+
+  for (y = year - 1; y <= year + 1; y++) {
+    time_t t;
+    int64_t diff;
+
+    if (!valid_date(y, mon, mday))
+      continue;
+    t = make_epoch(y, mon, mday, sod, KST_OFFSET);
+    diff = (int64_t)t > (int64_t)ref ? (int64_t)t - ref : (int64_t)ref - t;
+    if (diff < best_diff) {
+      best_diff = diff;
+      *out = t;
+    }
+  }
+  if (best_diff == INT64_MAX)
+    goto fail;
+  return 15;
+
+fail:
+  errno = EINVAL;
+  return 0;
+}
+
+size_t fastkst_parse_syslog(const char *s, size_t len, time_t ref, time_t *out)
+{
+  int64_t year;
+
+  if (s == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (!ref_year(ref, &year))
+    return 0;
+  return parse_syslog_year(s, len, ref, year, NULL, out);
+}
+
+size_t fastkst_parse_syslog_before(const char *s, size_t len, time_t ref, long slack,
+                                   time_t *out)
+{
+  int64_t year, limit;
+
+  if (s == NULL || out == NULL || slack < 0 || slack > 366L * SECS_PER_DAY) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (!ref_year(ref, &year))
+    return 0;
+  limit = (int64_t)ref + slack;
+  return parse_syslog_year(s, len, ref, year, &limit, out);
+}
+
+size_t fastkst_parse_http_date(const char *s, size_t len, time_t *out)
+{
+  int mday, mon, y, sod;
+
+  if (s == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (len < 29)
+    goto fail;
+
+  /* Wed, 31 Dec 2025 03:52:45 GMT */
+  mday = dig2(s + 5);
+  mon = month_of(s + 8);
+  y = dig4(s + 12);
+  sod = parse_hms(s + 17);
+  if (wday_of(s) < 0 || mday < 0 || mon < 0 || y < 0 || sod < 0 ||
+      s[3] != ',' || s[4] != ' ' || s[7] != ' ' || s[11] != ' ' ||
+      s[16] != ' ' || s[25] != ' ' || memcmp(s + 26, "GMT", 3) != 0 ||
+      !valid_date(y, mon, mday))
+    goto fail;
+
+  *out = make_epoch(y, mon, mday, sod, 0);
+  return 29;
+
+fail:
+  errno = EINVAL;
+  return 0;
+}
+
+/* RFC 2822 obs-zone names; military letters other than Z count as -0000 */
+static int named_zone(const char *p, size_t n, long *offset)
+{
+  static const struct {
+    char name[4];
+    int hours;
+  } zones[] = {
+    { "ut", 0 }, { "gmt", 0 }, { "est", -5 }, { "edt", -4 }, { "cst", -6 },
+    { "cdt", -5 }, { "mst", -7 }, { "mdt", -6 }, { "pst", -8 }, { "pdt", -7 }
+  };
+  char lower[3];
+  size_t i;
+
+  if (n == 1) {
+    *offset = 0;
+    return 0;
+  }
+  if (n > 3)
+    return -1;
+  for (i = 0; i < n; i++)
+    lower[i] = (char)(p[i] | 0x20);
+  for (i = 0; i < sizeof(zones) / sizeof(zones[0]); i++) {
+    if (strlen(zones[i].name) == n && memcmp(zones[i].name, lower, n) == 0) {
+      *offset = zones[i].hours * 3600L;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+static inline int is_alpha(char c)
+{
+  return (unsigned)((c | 0x20) - 'a') < 26;
+}
+
+size_t fastkst_parse_rfc2822(const char *s, size_t len, time_t *out)
+{
+  size_t p = 0, q;
+  int mday, mon, sod, hh, mm;
+  int64_t y;
+  long off;
+
+#define SKIP_WS() while (p < len && (s[p] == ' ' || s[p] == '\t')) p++
+
+  if (s == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  SKIP_WS();
+  if (p < len && is_alpha(s[p])) {
+    if (len - p < 4 || wday_of(s + p) < 0)
+      goto fail;
+    p += 3;
+    SKIP_WS();
+    if (p >= len || s[p] != ',')
+      goto fail;
+    p++;
+    SKIP_WS();
+  }
+
+  /* day: 1 or 2 digits */
+  if (p >= len || !is_digit(s[p]))
+    goto fail;
+  mday = s[p++] - '0';
+  if (p < len && is_digit(s[p]))
+    mday = mday * 10 + (s[p++] - '0');
+  q = p;
+  SKIP_WS();
+  if (p == q || len - p < 4 || (mon = month_of(s + p)) < 0)
+    goto fail;
+  p += 3;
+  q = p;
+  SKIP_WS();
+  if (p == q)
+    goto fail;
+
+  /* year: 4+ digits, or obsolete 2 / 3 digits */
+  q = p;
+  for (y = 0; p < len && is_digit(s[p]) && p - q < 9; p++)
+    y = y * 10 + (s[p] - '0');
+  if (p - q < 2)
+    goto fail;
+  if (p - q == 2)
+    y += y < 50 ? 2000 : 1900;
+  else if (p - q == 3)
+    y += 1900;
+  q = p;
+  SKIP_WS();
+  if (p == q)
+    goto fail;
+
+  /* time: HH:MM:SS or HH:MM */
+  if (len - p >= 8 && s[p + 5] == ':') {
+    if ((sod = parse_hms(s + p)) < 0)
+      goto fail;
+    p += 8;
+  } else {
+    if (len - p < 5 || s[p + 2] != ':' ||
+        (hh = dig2(s + p)) < 0 || hh > 23 || (mm = dig2(s + p + 3)) < 0 || mm > 59)
+      goto fail;
+    sod = hh * 3600 + mm * 60;
+    p += 5;
+  }
+  q = p;
+  SKIP_WS();
+  if (p == q || p >= len)
+    goto fail;
+
+  /* zone */
+  if (s[p] == '+' || s[p] == '-') {
+    if (len - p < 5 || parse_numeric_zone(s + p, &off) != 0)
+      goto fail;
+    p += 5;
+  } else {
+    q = p;
+    while (p < len && is_alpha(s[p]))
+      p++;
+    if (p == q || named_zone(s + q, p - q, &off) != 0)
+      goto fail;
+  }
+
+  if (!valid_date(y, mon, mday))
+    goto fail;
+  *out = make_epoch(y, mon, mday, sod, off);
+  return p;
+
+#undef SKIP_WS
+
+fail:
+  errno = EINVAL;
+  return 0;
+}
+
+size_t fastkst_parse_iso8601(const char *s, size_t len, time_t *out)
+{
+  size_t p;
+  int y, mon, mday, sod, hh, mm;
+  long off = KST_OFFSET;
+
+  if (s == NULL || out == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (len < 19)
+    goto fail;
+
+  /* 2025-12-31T12:52:45 */
+  y = dig4(s);
+  mon = dig2(s + 5) - 1;
+  mday = dig2(s + 8);
+  sod = parse_hms(s + 11);
+  if (y < 0 || mon < 0 || mon > 11 || mday < 0 || sod < 0 ||
+      s[4] != '-' || s[7] != '-' || (s[10] != 'T' && s[10] != 't' && s[10] != ' ') ||
+      !valid_date(y, mon, mday))
+    goto fail;
+  p = 19;
+
+  /* fraction is consumed, not kept */
+  if (p + 1 < len && (s[p] == '.' || s[p] == ',') && is_digit(s[p + 1])) {
+    p += 2;
+    while (p < len && is_digit(s[p]))
+      p++;
+  }
+
+  /* zone: Z, +hh, +hhmm, +hh:mm; none is KST */
+  if (p < len && (s[p] == 'Z' || s[p] == 'z')) {
+    off = 0;
+    p++;
+  } else if (p + 2 < len && (s[p] == '+' || s[p] == '-') &&
+             (hh = dig2(s + p + 1)) >= 0) {
+    size_t q = p + 3;
+
+    if (q + 2 < len && s[q] == ':' && (mm = dig2(s + q + 1)) >= 0)
+      q += 3;
+    else if (q + 1 < len && (mm = dig2(s + q)) >= 0)
+      q += 2;
+    else
+      mm = 0;
+    if (hh > 23 || mm > 59)
+      goto fail;
+    off = (hh * 3600L + mm * 60L) * (s[p] == '-' ? -1 : 1);
+    p = q;
+  }
+
+  *out = make_epoch(y, mon, mday, sod, off);
+  return p;
+
+fail:
+  errno = EINVAL;
+  return 0;
+}
+
+size_t fastkst_parse_batch(fastkst_log_format_t fmt, const char *const *lines,
+                           const size_t *lens, size_t n, time_t ref,
+                           time_t *out, unsigned char *ok)
+{
+  int64_t year = 0;
+  size_t i, parsed = 0;
+
+  if ((unsigned)fmt > FASTKST_FMT_ISO8601 ||
+      (n > 0 && (lines == NULL || lens == NULL || out == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (fmt == FASTKST_FMT_SYSLOG && !ref_year(ref, &year))
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    const char *s = lines[i];
+    size_t len = lens[i];
+    size_t r = 0;
+
+    switch (fmt) {
+    case FASTKST_FMT_CLF: {
+      const char *b = s ? memchr(s, '[', len) : NULL;
+      if (b)
+        r = fastkst_parse_clf(b, len - (size_t)(b - s), &out[i]);
+      break;
+    }
+    case FASTKST_FMT_SYSLOG:
+      if (s == NULL)
+        break;
+      if (len > 0 && s[0] == '<') {
+        const char *e = memchr(s, '>', len < 6 ? len : 6);
+        if (e == NULL)
+          break;
+        len -= (size_t)(e + 1 - s);
+        s = e + 1;
+      }
+      r = parse_syslog_year(s, len, ref, year, NULL, &out[i]);
+      break;
+    case FASTKST_FMT_HTTP:
+      if (s)
+        r = fastkst_parse_http_date(s, len, &out[i]);
+      break;
+    case FASTKST_FMT_RFC2822:
+      if (s)
+        r = fastkst_parse_rfc2822(s, len, &out[i]);
+      break;
+    case FASTKST_FMT_ISO8601:
+      if (s)
+        r = fastkst_parse_iso8601(s, len, &out[i]);
+      break;
+    }
+
+    if (r == 0)
+      out[i] = (time_t)-1;
+    else
+      parsed++;
+    if (ok)
+      ok[i] = r != 0;
+  }
+  return parsed;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_PARSE
+/* 빌드 방법
+gcc -DTEST_FASTKST_PARSE -o fastkst_parse_test fastkst_parse.c fastkst_localtime.c
+./fastkst_parse_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static const char *const mon_names[12] = {
+  "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+static const char *const wday_names[7] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static time_t parse_str(size_t (*fn)(const char *, size_t, time_t *), const char *s, size_t *used)
+{
+  time_t t = 0;
+  *used = fn(s, strlen(s), &t);
+  return *used ? t : (time_t)-1;
+}
+
+int main(void)
+{
+  const time_t ref = 1767153165;    /* 2025-12-31 12:52:45 KST */
+  char buf[64];
+  time_t t;
+  size_t used;
+  int i, bad;
+
+  printf("=== FASTKST_PARSE Test ===\n\n");
+
+  /* Name hashes */
+  bad = 0;
+  for (i = 0; i < 12; i++) {
+    char up[4] = { (char)(mon_names[i][0] & ~0x20), (char)(mon_names[i][1] & ~0x20),
+                   (char)(mon_names[i][2] & ~0x20), 0 };
+    bad += month_of(mon_names[i]) != i || month_of(up) != i;
+  }
+  for (i = 0; i < 7; i++)
+    bad += wday_of(wday_names[i]) != i;
+  bad += month_of("Jum") >= 0 || month_of("D3c") >= 0 || wday_of("Wen") >= 0 || wday_of("Jan") >= 0;
+  CHECK(bad == 0, "month/weekday perfect hash");
+
+  /* Fixed examples */
+  t = parse_str(fastkst_parse_clf, "[31/Dec/2025:12:52:45 +0900] \"GET /\"", &used);
+  CHECK(t == ref && used == 28, "CLF with brackets");
+  t = parse_str(fastkst_parse_clf, "31/Dec/2025:03:52:45 +0000", &used);
+  CHECK(t == ref && used == 26, "CLF in UTC");
+  t = parse_str(fastkst_parse_http_date, "Wed, 31 Dec 2025 03:52:45 GMT", &used);
+  CHECK(t == ref && used == 29, "HTTP IMF-fixdate");
+  t = parse_str(fastkst_parse_rfc2822, "Wed, 31 Dec 2025 12:52:45 +0900 (KST)", &used);
+  CHECK(t == ref && used == 31, "RFC 2822");
+  t = parse_str(fastkst_parse_rfc2822, "31 dec 25 03:52 GMT", &used);
+  CHECK(t == ref - 45, "RFC 2822 without weekday and seconds, 2-digit year");
+  t = parse_str(fastkst_parse_rfc2822, "Tue,  30  Dec 2025 22:52:45 EST", &used);
+  CHECK(t == ref, "RFC 2822 obsolete zone and extra spaces");
+  t = parse_str(fastkst_parse_iso8601, "2025-12-31T12:52:45 INFO x", &used);
+  CHECK(t == ref && used == 19, "ISO 8601 without zone is KST");
+  t = parse_str(fastkst_parse_iso8601, "2025-12-31 03:52:45,123Z app", &used);
+  CHECK(t == ref && used == 24, "ISO 8601 with fraction and Z");
+  t = parse_str(fastkst_parse_iso8601, "2025-12-30T22:52:45.5-05:00", &used);
+  CHECK(t == ref && used == 27, "ISO 8601 with +hh:mm");
+  t = parse_str(fastkst_parse_iso8601, "2025-12-31T12:52:45+0900]", &used);
+  CHECK(t == ref && used == 24, "ISO 8601 with +hhmm");
+  t = parse_str(fastkst_parse_iso8601, "2025-12-31T03:52:45+00", &used);
+  CHECK(t == ref && used == 22, "ISO 8601 with +hh");
+  CHECK(fastkst_parse_syslog("Dec 31 12:52:45 host app: x", 27, ref, &t) == 15 && t == ref,
+        "syslog in the reference year");
+  CHECK(fastkst_parse_syslog("Jan  1 00:00:10 host", 20, ref, &t) == 15 &&
+        t == ref + 11 * 3600 + 7 * 60 + 25, "syslog day padded, rolls into next year");
+  CHECK(fastkst_parse_syslog("Dec 31 23:59:59", 15, ref + 3 * 86400, &t) == 15 &&
+        t == ref + 11 * 3600 + 7 * 60 + 14, "syslog read in January is last year");
+  {
+    const time_t mtime = 1792249200;      /* 2026-10-18 00:00:00 KST, mid-year */
+    time_t t2;
+
+    /* closest year puts Dec 31 after the file was written; "before" does not */
+    CHECK(fastkst_parse_syslog("Dec 31 12:00:02 host b1", 23, mtime, &t) == 15 &&
+          t > mtime, "syslog closest year can be after ref");
+    CHECK(fastkst_parse_syslog_before("Dec 31 12:00:02 host b1", 23, mtime, 3600, &t) == 15 &&
+          t == ref - 52 * 60 - 43 && fastkst_parse_syslog_before("Jan  1 00:00:10", 15, mtime, 3600, &t2) == 15 &&
+          t2 == ref + 11 * 3600 + 7 * 60 + 25, "syslog year-end lines with a mid-year mtime");
+    CHECK(fastkst_parse_syslog_before("Oct 18 00:30:00", 15, mtime, 3600, &t) == 15 &&
+          t == mtime + 1800 &&
+          fastkst_parse_syslog_before("Oct 18 01:30:00", 15, mtime, 3600, &t) == 15 &&
+          t == mtime + 5400 - 365 * 86400, "syslog before: slack for clock skew");
+    CHECK(fastkst_parse_syslog_before("Feb 29 00:00:00", 15, mtime, 0, &t) == 15 &&
+          t == make_epoch(2024, 1, 29, 0, KST_OFFSET) &&
+          fastkst_parse_syslog_before("Feb 29 00:00:00", 15, mtime, -1, &t) == 0,
+          "syslog before: Feb 29 goes back to a leap year");
+  }
+
+  /* Rejections */
+  bad = 0;
+  bad += parse_str(fastkst_parse_clf, "31/Dex/2025:12:52:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_clf, "30/Feb/2025:12:52:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_clf, "31/Dec/2025:24:52:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_clf, "31/Dec/2025:12-52:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_clf, "31/Dec/2025:12:5:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_clf, "[31/Dec/2025:12:52:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_http_date, "Wed, 31 Dec 2025 03:52:45 UTC", &used) != -1;
+  bad += parse_str(fastkst_parse_rfc2822, "Wed 31 Dec 2025 12:52:45 +0900", &used) != -1;
+  bad += parse_str(fastkst_parse_rfc2822, "31 Dec 2025 12:52:45", &used) != -1;
+  bad += parse_str(fastkst_parse_iso8601, "2025-02-29T00:00:00", &used) != -1;
+  bad += parse_str(fastkst_parse_iso8601, "2025-13-01T00:00:00", &used) != -1;
+  bad += parse_str(fastkst_parse_iso8601, "2025-12-31X12:52:45", &used) != -1;
+  bad += parse_str(fastkst_parse_iso8601, "2025-12-31T12:52", &used) != -1;
+  bad += parse_str(fastkst_parse_iso8601, "2025-12-31T12:52:45+25:00", &used) != -1;
+  bad += fastkst_parse_syslog("Feb 29 00:00:00", 15, ref, &t) == 0;   /* 2024 is closest */
+  bad += fastkst_parse_syslog("Dec 31 12:52", 12, ref, &t) != 0;
+  CHECK(bad == 0, "malformed input rejected");
+
+  /* Round trips against strftime() over a wide range */
+  bad = 0;
+  srand(84);
+  for (i = 0; i < 200000; i++) {
+    time_t x = (time_t)(((int64_t)rand() << 16 ^ rand()) % ((int64_t)250 * 365 * 86400)) -
+               (time_t)70 * 365 * 86400;
+    long off = (rand() % 49 - 24) * 1800L;
+    struct tm tm;
+    char sign = off < 0 ? '-' : '+';
+    long a = off < 0 ? -off : off;
+
+    __offtime64(x, off, &tm);
+    snprintf(buf, sizeof(buf), "[%02d/%s/%04d:%02d:%02d:%02d %c%02ld%02ld]",
+             tm.tm_mday, mon_names[tm.tm_mon], tm.tm_year + 1900,
+             tm.tm_hour, tm.tm_min, tm.tm_sec, sign, a / 3600, a % 3600 / 60);
+    bad += parse_str(fastkst_parse_clf, buf, &used) != x;
+    snprintf(buf, sizeof(buf), "%s, %d %s %04d %02d:%02d:%02d %c%02ld%02ld",
+             wday_names[tm.tm_wday], tm.tm_mday, mon_names[tm.tm_mon], tm.tm_year + 1900,
+             tm.tm_hour, tm.tm_min, tm.tm_sec, sign, a / 3600, a % 3600 / 60);
+    bad += parse_str(fastkst_parse_rfc2822, buf, &used) != x;
+    snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d.%03d%c%02ld:%02ld",
+             tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+             tm.tm_hour, tm.tm_min, tm.tm_sec, i % 1000, sign, a / 3600, a % 3600 / 60);
+    bad += parse_str(fastkst_parse_iso8601, buf, &used) != x || used != 29;
+
+    gmtime_r(&x, &tm);
+    strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    bad += parse_str(fastkst_parse_http_date, buf, &used) != x;
+
+    fastkst_localtime(x, &tm);
+    strftime(buf, sizeof(buf), "%b %e %H:%M:%S", &tm);
+    bad += fastkst_parse_syslog(buf, 15, x + (rand() % (300 * 86400)) - 150 * 86400, &t) != 15 || t != x;
+  }
+  CHECK(bad == 0, "round trips (CLF, RFC 2822, ISO 8601, HTTP, syslog)");
+
+  /* Batch, with a comparison against strptime() + timegm() */
+  {
+    enum { N = 200000 };
+    static char text[N][32];
+    static const char *lines[N];
+    static size_t lens[N];
+    static time_t out[N], want[N];
+    static unsigned char ok[N];
+    double t0, t1, t2;
+    size_t n;
+    struct tm tm;
+
+    for (i = 0; i < N; i++) {
+      want[i] = ref - i * 7;
+      fastkst_localtime(want[i], &tm);
+      strftime(text[i], sizeof(text[i]), "[%d/%b/%Y:%H:%M:%S +0900]", &tm);
+      lines[i] = text[i];
+      lens[i] = strlen(text[i]);
+    }
+    text[5][4] = 'X';
+
+    t0 = now_sec();
+    n = fastkst_parse_batch(FASTKST_FMT_CLF, lines, lens, N, 0, out, ok);
+    t1 = now_sec();
+    for (i = 0; i < N; i++) {
+      memset(&tm, 0, sizeof(tm));
+      strptime(text[i] + 1, "%d/%b/%Y:%H:%M:%S", &tm);
+      want[i] = timegm(&tm) - KST_OFFSET;
+    }
+    t2 = now_sec();
+
+    bad = 0;
+    for (i = 0; i < N; i++)
+      bad += i == 5 ? (ok[i] != 0 || out[i] != -1) : (ok[i] != 1 || out[i] != want[i]);
+    CHECK(n == N - 1 && bad == 0, "CLF batch skips the bad line and matches strptime()");
+    printf("  %d lines: batch %.1f ms, strptime+timegm %.1f ms\n",
+           N, (t1 - t0) * 1e3, (t2 - t1) * 1e3);
+  }
+
+  {
+    const char *sl[2] = { "<34>Oct 11 22:14:15 mymachine su: 'su root' failed", "garbage" };
+    size_t sll[2] = { strlen(sl[0]), strlen(sl[1]) };
+    time_t so[2];
+
+    CHECK(fastkst_parse_batch(FASTKST_FMT_SYSLOG, sl, sll, 2, ref, so, NULL) == 1 &&
+          so[0] == make_epoch(2025, 9, 11, 22 * 3600 + 14 * 60 + 15, KST_OFFSET) && so[1] == -1,
+          "syslog batch with <PRI>");
+  }
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All parse tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d parse test(s) failed!\n", failures);
+  return 1;
+}
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file fastkst_parse.h
+ * @brief Fixed-layout log timestamp parsers (CLF, RFC 3164, HTTP-date, RFC 2822,
+ *        ISO 8601)
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Replacement for strptime() + mktime()/timegm() on hot ingest paths:
+ *    month and weekday names go through a perfect hash, HH:MM:SS is
+ *    converted eight bytes at a time, and the result is computed with
+ *    civil-to-epoch arithmetic (no struct tm, no TZ lookup).
+ *  - Timestamps without a zone (RFC 3164 syslog, ISO 8601 without an
+ *    offset) are taken as KST (UTC+9).
+ *  - Parsers return the number of bytes consumed so the caller can continue
+ *    with the rest of the line; 0 means the input does not match (EINVAL).
+ */
+
+#ifndef FASTKST_PARSE_H
+#define FASTKST_PARSE_H
+
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Timestamp layouts understood by fastkst_parse_batch()
+ */
+typedef enum {
+  FASTKST_FMT_CLF     = 0,    /**< nginx/Apache: [31/Dec/2025:12:52:45 +0900] */
+  FASTKST_FMT_SYSLOG  = 1,    /**< RFC 3164: Dec 31 12:52:45 (KST, no year) */
+  FASTKST_FMT_HTTP    = 2,    /**< IMF-fixdate: Wed, 31 Dec 2025 03:52:45 GMT */
+  FASTKST_FMT_RFC2822 = 3,    /**< mail: [Wed, ]31 Dec 2025 12:52:45 +0900 */
+  FASTKST_FMT_ISO8601 = 4     /**< 2025-12-31T12:52:45[.123][+09:00] */
+} fastkst_log_format_t;
+
+/**
+ * @brief Parse a Common Log Format timestamp
+ * @param[in] s "31/Dec/2025:12:52:45 +0900", optionally enclosed in [ ]
+ * @param[in] len bytes available at s
+ * @param[out] out UTC epoch seconds
+ * @return size_t bytes consumed (including the brackets), 0 on failure
+ */
+size_t fastkst_parse_clf(const char *s, size_t len, time_t *out);
+
+/**
+ * @brief Parse an RFC 3164 syslog timestamp
+ * @param[in] s "Dec 31 12:52:45" (day space padded: "Jan  1")
+ * @param[in] len bytes available at s
+ * @param[in] ref reference time; the year (ref's year - 1, + 0 or + 1) is
+ *            the one putting the KST timestamp closest to ref (a December
+ *            line read in January belongs to the previous year). This is
+ *            not a "not later than ref" rule: the result can be up to half
+ *            a year after ref, so ref should be a time near the line (e.g.
+ *            now, for live logs), not an upper bound such as a file mtime
+ *            (use fastkst_parse_syslog_before() for that).
+ * @param[out] out UTC epoch seconds
+ * @return size_t bytes consumed, 0 on failure
+ */
+size_t fastkst_parse_syslog(const char *s, size_t len, time_t ref, time_t *out);
+
+/**
+ * @brief Parse an RFC 3164 syslog timestamp that is known not to be later
+ *        than ref (plus slack)
+ * @param[in] s "Dec 31 12:52:45" (day space padded: "Jan  1")
+ * @param[in] len bytes available at s
+ * @param[in] ref upper bound, e.g. the mtime of the file the line is from;
+ *            the year is the latest one putting the KST timestamp at or
+ *            before ref + slack
+ * @param[in] slack seconds of tolerance for clock skew, 0..366 days
+ * @param[out] out UTC epoch seconds
+ * @return size_t bytes consumed, 0 on failure
+ */
+size_t fastkst_parse_syslog_before(const char *s, size_t len, time_t ref, long slack,
+                                   time_t *out);
+
+/**
+ * @brief Parse an HTTP-date in the preferred IMF-fixdate layout (RFC 9110)
+ * @param[in] s "Wed, 31 Dec 2025 03:52:45 GMT"
+ * @param[in] len bytes available at s
+ * @param[out] out UTC epoch seconds
+ * @return size_t bytes consumed (29), 0 on failure
+ */
+size_t fastkst_parse_http_date(const char *s, size_t len, time_t *out);
+
+/**
+ * @brief Parse an RFC 2822 date-time
+ * @param[in] s "[Wed, ]31 Dec 2025 12:52:45 +0900"; the day may have one
+ *            digit, seconds are optional, two- and three-digit years and
+ *            the UT/GMT/Z and US zone names of RFC 2822 section 4.3 are
+ *            accepted, names are case-insensitive
+ * @param[in] len bytes available at s
+ * @param[out] out UTC epoch seconds
+ * @return size_t bytes consumed, 0 on failure
+ */
+size_t fastkst_parse_rfc2822(const char *s, size_t len, time_t *out);
+
+/**
+ * @brief Parse an ISO 8601 / RFC 3339 date-time (application log layout)
+ * @param[in] s "2025-12-31T12:52:45", 'T' may be a space; then an optional
+ *            fraction (".123" or ",123", consumed but not kept) and an
+ *            optional zone "Z", "+09", "+0900" or "+09:00" (none: KST)
+ * @param[in] len bytes available at s
+ * @param[out] out UTC epoch seconds
+ * @return size_t bytes consumed, 0 on failure
+ */
+size_t fastkst_parse_iso8601(const char *s, size_t len, time_t *out);
+
+/**
+ * @brief Parse the timestamp of each line
+ * @param[in] fmt timestamp layout
+ * @param[in] lines line pointers; a CLF timestamp is found at the first '[',
+ *            a syslog one after an optional "<PRI>", others at the start
+ * @param[in] lens line lengths
+ * @param[in] n number of lines
+ * @param[in] ref reference time for FASTKST_FMT_SYSLOG (ignored otherwise)
+ * @param[out] out UTC epoch seconds, (time_t)-1 for lines that do not parse
+ * @param[out] ok 1 / 0 per line (optional, can be NULL)
+ * @return size_t number of lines parsed; unlike the other batch functions a
+ *         bad line does not stop the batch
+ */
+size_t fastkst_parse_batch(fastkst_log_format_t fmt, const char *const *lines,
+                           const size_t *lens, size_t n, time_t ref,
+                           time_t *out, unsigned char *ok);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_PARSE_H */
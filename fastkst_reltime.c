@@ -0,0 +1,329 @@
+/**
+ * @file fastkst_reltime.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Korean relative-time labels ("방금 전", "3분 전", "어제 오후 3:05") in KST
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - This file is UTF-8: the label fragments below are emitted byte for byte.
+ *  - Test code: enabled with TEST_FASTKST_RELTIME
+ */
+#include <time.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "fastkst_reltime.h"
+#include "fastkst_internal.h"
+
+typedef struct {
+  const char *s;
+  unsigned char len;
+} fragment_t;
+
+#define FRAG(str) { str, sizeof(str) - 1 }
+
+static const fragment_t frag_just_now = FRAG("방금 전");
+static const fragment_t frag_min_ago  = FRAG("분 전");
+static const fragment_t frag_hour_ago = FRAG("시간 전");
+static const fragment_t frag_today    = FRAG("오늘 ");
+static const fragment_t frag_yday     = FRAG("어제 ");
+static const fragment_t frag_am       = FRAG("오전 ");
+static const fragment_t frag_pm       = FRAG("오후 ");
+static const fragment_t frag_year     = FRAG("년 ");
+static const fragment_t frag_month    = FRAG("월 ");
+static const fragment_t frag_day      = FRAG("일");
+
+/* tm_wday order, each followed by a space */
+static const fragment_t frag_wday[7] = {
+  FRAG("일요일 "), FRAG("월요일 "), FRAG("화요일 "), FRAG("수요일 "),
+  FRAG("목요일 "), FRAG("금요일 "), FRAG("토요일 ")
+};
+
+typedef struct {
+  char *p;
+  char *end;     /* last usable byte is end - 1, keeping room for the NUL */
+  int ok;
+} out_t;
+
+static inline void put_frag(out_t *o, const fragment_t *f)
+{
+  if (o->end - o->p < f->len) {
+    o->ok = 0;
+    return;
+  }
+  memcpy(o->p, f->s, f->len);
+  o->p += f->len;
+}
+
+static inline void put_uint(out_t *o, uint64_t v)
+{
+  char tmp[20];
+  int n = 0;
+
+  do {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+
+  if (o->end - o->p < n) {
+    o->ok = 0;
+    return;
+  }
+  while (n)
+    *o->p++ = tmp[--n];
+}
+
+static inline void put_int(out_t *o, int64_t v)
+{
+  if (v < 0) {
+    if (o->p == o->end) {
+      o->ok = 0;
+      return;
+    }
+    *o->p++ = '-';
+  }
+  put_uint(o, v < 0 ? 0 - (uint64_t)v : (uint64_t)v);
+}
+
+/* "오후 3:05" */
+static inline void put_clock(out_t *o, int64_t sod)
+{
+  unsigned hour = (unsigned)(sod / SECS_PER_HOUR);
+  unsigned min = (unsigned)(sod % SECS_PER_HOUR / 60);
+  unsigned h12 = hour % 12 == 0 ? 12 : hour % 12;
+
+  put_frag(o, hour < 12 ? &frag_am : &frag_pm);
+  put_uint(o, h12);
+  if (o->end - o->p < 3) {
+    o->ok = 0;
+    return;
+  }
+  *o->p++ = ':';
+  fastkst_put2(o->p, min);
+  o->p += 2;
+}
+
+void fastkst_reltime_default_opts(fastkst_reltime_opts_t *opts)
+{
+  opts->just_now = 60;
+  opts->minutes = SECS_PER_HOUR;
+  opts->hours = 6 * SECS_PER_HOUR;
+  opts->weekday_days = 7;
+}
+
+int fastkst_reltime_init(fastkst_reltime_t *ctx, time_t now,
+                         const fastkst_reltime_opts_t *opts)
+{
+  struct tm tm;
+
+  if (ctx == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+  if (opts)
+    ctx->opts = *opts;
+  else
+    fastkst_reltime_default_opts(&ctx->opts);
+
+  if (__offtime64(now, KST_OFFSET, &tm) != 1)
+    return 0;
+
+  ctx->now = now;
+  ctx->now_day = fastkst_floor_div((int64_t)now + KST_OFFSET, SECS_PER_DAY);
+  ctx->year_first_day = ctx->now_day - tm.tm_yday;
+  ctx->year_end_day = ctx->year_first_day + (__isleap((int64_t)tm.tm_year + 1900) ? 366 : 365);
+  return 1;
+}
+
+size_t fastkst_reltime_format(const fastkst_reltime_t *ctx, time_t t,
+                              char *buf, size_t size)
+{
+  const fastkst_reltime_opts_t *opts = &ctx->opts;
+  int64_t d = (int64_t)ctx->now - (int64_t)t;
+  int64_t local = (int64_t)t + KST_OFFSET;
+  int64_t day = fastkst_floor_div(local, SECS_PER_DAY);
+  int64_t sod = local - day * SECS_PER_DAY;
+  int64_t ddays = ctx->now_day - day;
+  out_t o;
+
+  if (buf == NULL || size == 0)
+    return 0;
+  o.p = buf;
+  o.end = buf + size - 1;
+  o.ok = 1;
+
+  if (d >= 0 && d < opts->just_now) {
+    put_frag(&o, &frag_just_now);
+  } else if (d >= 0 && d < opts->minutes) {
+    put_uint(&o, (uint64_t)(d / 60));
+    put_frag(&o, &frag_min_ago);
+  } else if (d >= 0 && d < opts->hours) {
+    put_uint(&o, (uint64_t)(d / SECS_PER_HOUR));
+    put_frag(&o, &frag_hour_ago);
+  } else if (ddays == 0) {
+    put_frag(&o, &frag_today);
+    put_clock(&o, sod);
+  } else if (ddays == 1) {
+    put_frag(&o, &frag_yday);
+    put_clock(&o, sod);
+  } else if (ddays > 1 && ddays < opts->weekday_days) {
+    int wday = (int)((4 + day) % 7);
+
+    put_frag(&o, &frag_wday[wday < 0 ? wday + 7 : wday]);
+    put_clock(&o, sod);
+  } else {
+    struct tm tm;
+
+    if (__offtime64(t, KST_OFFSET, &tm) != 1)
+      return 0;
+    if (day < ctx->year_first_day || day >= ctx->year_end_day) {
+      put_int(&o, (int64_t)tm.tm_year + 1900);
+      put_frag(&o, &frag_year);
+    }
+    put_uint(&o, (uint64_t)tm.tm_mon + 1);
+    put_frag(&o, &frag_month);
+    put_uint(&o, (uint64_t)tm.tm_mday);
+    put_frag(&o, &frag_day);
+  }
+
+  if (!o.ok)
+    return 0;
+  *o.p = '\0';
+  return (size_t)(o.p - buf);
+}
+
+size_t fastkst_reltime_format_batch(const fastkst_reltime_t *ctx,
+                                    const time_t *t, size_t n,
+                                    char *buf, size_t stride, size_t *lens)
+{
+  size_t i, done = 0;
+
+  if (ctx == NULL || (n > 0 && (t == NULL || buf == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    size_t len = fastkst_reltime_format(ctx, t[i], buf + i * stride, stride);
+
+    if (lens)
+      lens[i] = len;
+    done += len != 0;
+  }
+  return done;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_RELTIME
+/* 빌드 방법
+gcc -DTEST_FASTKST_RELTIME -o fastkst_reltime_test fastkst_reltime.c fastkst_localtime.c
+./fastkst_reltime_test
+*/
+#include <stdio.h>
+#include <sys/time.h>
+
+static int failures = 0;
+
+static void expect(const fastkst_reltime_t *ctx, time_t t, const char *want)
+{
+  char buf[32];                     /* the documented worst case */
+  size_t len = fastkst_reltime_format(ctx, t, buf, sizeof(buf));
+
+  if (len == 0 || strcmp(buf, want) != 0 || len != strlen(want)) {
+    printf("[FAIL] %lld: got \"%s\", want \"%s\"\n", (long long)t, len ? buf : "", want);
+    failures++;
+  } else {
+    printf("[PASS] %s\n", want);
+  }
+}
+
+static double get_time_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec * 1000000.0 + (double)tv.tv_usec;
+}
+
+int main(void)
+{
+  /* now: 2025-12-31 (Wed) 15:05:00 KST */
+  const time_t now = 1767161100;
+  fastkst_reltime_t ctx;
+  fastkst_reltime_opts_t opts;
+  char small[8];
+
+  printf("=== FASTKST_RELTIME Test ===\n\n");
+  fastkst_reltime_init(&ctx, now, NULL);
+
+  expect(&ctx, now, "방금 전");
+  expect(&ctx, now - 59, "방금 전");
+  expect(&ctx, now - 60, "1분 전");
+  expect(&ctx, now - 3599, "59분 전");
+  expect(&ctx, now - 3600, "1시간 전");
+  expect(&ctx, now - 5 * 3600 - 1, "5시간 전");
+  expect(&ctx, now - 6 * 3600, "오늘 오전 9:05");           /* 09:05 */
+  expect(&ctx, now - 15 * 3600 - 300, "오늘 오전 12:00");   /* 00:00 */
+  expect(&ctx, now - 15 * 3600 - 301, "어제 오후 11:59");
+  expect(&ctx, now - 86400, "어제 오후 3:05");
+  expect(&ctx, now - 2 * 86400, "월요일 오후 3:05");
+  expect(&ctx, now - 6 * 86400, "목요일 오후 3:05");
+  expect(&ctx, now - 7 * 86400, "12월 24일");
+  expect(&ctx, 1735657200, "1월 1일");                      /* same year */
+  expect(&ctx, 1735657199, "2024년 12월 31일");
+  expect(&ctx, now + 3600, "오늘 오후 4:05");                /* future, same day */
+  expect(&ctx, now + 86400, "2026년 1월 1일");               /* future, next year */
+  expect(&ctx, -62167338000LL, "-1년 12월 31일");            /* years before 1 are signed */
+  expect(&ctx, -67768040578237200LL, "-2147481748년 12월 31일");
+  expect(&ctx, 67768036191558000LL, "2147485547년 12월 31일");
+
+  /* Configurable thresholds */
+  fastkst_reltime_default_opts(&opts);
+  opts.hours = 0;
+  opts.weekday_days = 2;
+  fastkst_reltime_init(&ctx, now, &opts);
+  expect(&ctx, now - 3600, "오늘 오후 2:05");
+  expect(&ctx, now - 2 * 86400, "12월 29일");
+
+  /* Buffer too small */
+  if (fastkst_reltime_format(&ctx, now - 3 * 86400, small, sizeof(small)) != 0) {
+    printf("[FAIL] small buffer accepted\n");
+    failures++;
+  } else {
+    printf("[PASS] small buffer rejected\n");
+  }
+
+  /* Batch benchmark */
+  {
+    enum { N = 1000000, STRIDE = 32 };
+    static time_t items[N];
+    static char out[N * STRIDE];
+    double start, end;
+    size_t i, done;
+
+    fastkst_reltime_init(&ctx, now, NULL);
+    for (i = 0; i < N; i++)
+      items[i] = now - (time_t)((i * 7919) % (86400 * 30));
+
+    start = get_time_usec();
+    done = fastkst_reltime_format_batch(&ctx, items, N, out, STRIDE, NULL);
+    end = get_time_usec();
+    printf("\n=== Performance Benchmark ===\n\n");
+    printf("fastkst_reltime_format_batch(): %.1f ns/label\n\n", (end - start) * 1000.0 / N);
+    if (done != N) {
+      printf("[FAIL] batch formatted %zu of %d\n", done, N);
+      failures++;
+    }
+  }
+
+  if (failures == 0) {
+    printf("[PASS] All reltime tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d reltime test(s) failed!\n", failures);
+  return 1;
+}
+#endif
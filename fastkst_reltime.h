@@ -0,0 +1,104 @@
+/**
+ * @file fastkst_reltime.h
+ * @brief Korean relative-time labels ("방금 전", "3분 전", "어제 오후 3:05") in KST
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - "now" is decomposed once into a context; each item then needs only its
+ *    KST epoch day and second of day. The full date is decomposed only for
+ *    the date layouts (older than weekday_days).
+ *  - Output is UTF-8, assembled from precomputed fragments into caller buffers.
+ *  - Layouts, by elapsed time d = now - t and KST calendar-day difference:
+ *      d < just_now                   방금 전
+ *      d < minutes                    N분 전
+ *      d < hours                      N시간 전
+ *      same day                       오늘 오후 3:05
+ *      previous day                   어제 오전 9:30
+ *      fewer than weekday_days days   화요일 오후 3:05
+ *      same year                      3월 5일
+ *      otherwise                      2024년 3월 5일
+ *    Future timestamps use the calendar layouts (오늘 ... or the date).
+ */
+
+#ifndef FASTKST_RELTIME_H
+#define FASTKST_RELTIME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Granularity thresholds
+ */
+typedef struct {
+  int64_t just_now;      /**< seconds, default 60 */
+  int64_t minutes;       /**< seconds, default 3600 */
+  int64_t hours;         /**< seconds, default 6 * 3600 (0 disables "N시간 전") */
+  int weekday_days;      /**< calendar days, default 7 (2 disables weekday labels) */
+} fastkst_reltime_opts_t;
+
+/**
+ * @brief Formatting context for one reference "now"
+ */
+typedef struct {
+  fastkst_reltime_opts_t opts;
+  time_t now;
+  int64_t now_day;          /**< KST epoch day of now */
+  int64_t year_first_day;   /**< KST epoch day of January 1 of now's year */
+  int64_t year_end_day;     /**< KST epoch day of January 1 of the next year */
+} fastkst_reltime_t;
+
+/**
+ * @brief Fill opts with the default thresholds
+ */
+void fastkst_reltime_default_opts(fastkst_reltime_opts_t *opts);
+
+/**
+ * @brief Prepare a context for a reference time
+ * @param[out] ctx context
+ * @param[in] now reference time
+ * @param[in] opts thresholds (NULL for defaults)
+ * @return int 1 on success, 0 on failure (EINVAL, EOVERFLOW)
+ */
+int fastkst_reltime_init(fastkst_reltime_t *ctx, time_t now,
+                         const fastkst_reltime_opts_t *opts);
+
+/**
+ * @brief Format one label
+ * @param[in] ctx context
+ * @param[in] t item time
+ * @param[out] buf output buffer (NUL-terminated on success)
+ * @param[in] size buffer size; 32 bytes always suffice (the longest label is
+ *            a signed 11-character year, e.g. "-2147481748년 12월 31일")
+ * @return size_t bytes written excluding the NUL, 0 if buf is too small
+ */
+size_t fastkst_reltime_format(const fastkst_reltime_t *ctx, time_t t,
+                              char *buf, size_t size);
+
+/**
+ * @brief Format labels in batch
+ * @param[in] ctx context
+ * @param[in] t item times
+ * @param[in] n number of items
+ * @param[out] buf output, one NUL-terminated label every stride bytes
+ * @param[in] stride bytes per label
+ * @param[out] lens label lengths (optional, can be NULL; 0 marks a failure)
+ * @return size_t number of labels formatted successfully
+ */
+size_t fastkst_reltime_format_batch(const fastkst_reltime_t *ctx,
+                                    const time_t *t, size_t n,
+                                    char *buf, size_t stride, size_t *lens);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_RELTIME_H */
@@ -0,0 +1,261 @@
+/**
+ * @file fastkst_sigsafe.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Async-signal-safe KST timestamp formatting
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Does not go through __offtime64() / fastkst_localtime(): both report
+ *    errors through errno. The date comes from fastkst_civil_from_days(),
+ *    which is plain integer arithmetic.
+ *  - Keep this file free of any other library call; see check-sigsafe in
+ *    the Makefile.
+ *  - Test code: enabled with TEST_FASTKST_SIGSAFE
+ */
+#include <time.h>
+#include <stdint.h>
+
+#include "fastkst_sigsafe.h"
+#include "fastkst_internal.h"
+
+/* Signed decimal, at least 4 digits; returns the end */
+static char *put_year(char *p, int64_t y)
+{
+  char tmp[24];
+  uint64_t u;
+  int n = 0;
+
+  if (y >= 0 && y <= 9999) {
+    fastkst_put2(p, (unsigned)(y / 100));
+    fastkst_put2(p + 2, (unsigned)(y % 100));
+    return p + 4;
+  }
+  if (y < 0) {
+    *p++ = '-';
+    u = (uint64_t)0 - (uint64_t)y;
+  } else {
+    *p++ = '+';
+    u = (uint64_t)y;
+  }
+  do {
+    tmp[n++] = (char)('0' + u % 10);
+    u /= 10;
+  } while (u);
+  while (n < 4)
+    tmp[n++] = '0';
+  while (n)
+    *p++ = tmp[--n];
+  return p;
+}
+
+size_t fastkst_sigsafe_format(time_t t, long nsec, int precision,
+                              char *buf, size_t size)
+{
+  char tmp[FASTKST_SIGSAFE_BUFSIZE];
+  char *p = tmp;
+  int64_t lt, day, sod, y;
+  int m, d, i;
+  size_t len;
+
+  if (buf == NULL || size == 0)
+    return 0;
+  buf[0] = '\0';
+  if (precision < 0 || precision > 9 || nsec < 0 || nsec > 999999999L ||
+      (int64_t)t > INT64_MAX - KST_OFFSET)
+    return 0;
+
+  lt = (int64_t)t + KST_OFFSET;
+  day = fastkst_floor_div(lt, SECS_PER_DAY);
+  sod = lt - day * SECS_PER_DAY;
+  fastkst_civil_from_days(day, &y, &m, &d);
+
+  p = put_year(p, y);
+  *p++ = '-';
+  fastkst_put2(p, (unsigned)m);
+  p[2] = '-';
+  fastkst_put2(p + 3, (unsigned)d);
+  p[5] = ' ';
+  fastkst_put2(p + 6, (unsigned)(sod / SECS_PER_HOUR));
+  p[8] = ':';
+  fastkst_put2(p + 9, (unsigned)(sod / 60 % 60));
+  p[11] = ':';
+  fastkst_put2(p + 12, (unsigned)(sod % 60));
+  p += 14;
+
+  if (precision > 0) {
+    unsigned long frac = (unsigned long)nsec;
+
+    for (i = precision; i < 9; i++)
+      frac /= 10;
+    *p++ = '.';
+    for (i = precision - 1; i >= 0; i--) {
+      p[i] = (char)('0' + frac % 10);
+      frac /= 10;
+    }
+    p += precision;
+  }
+
+  len = (size_t)(p - tmp);
+  if (len >= size)
+    return 0;
+  for (i = 0; i < (int)len; i++)
+    buf[i] = tmp[i];
+  buf[len] = '\0';
+  return len;
+}
+
+size_t fastkst_sigsafe_now(char *buf, size_t size, int precision)
+{
+  struct timespec ts;
+
+  if (buf == NULL || size == 0)
+    return 0;
+  buf[0] = '\0';
+  if (clock_gettime(CLOCK_REALTIME, &ts) != 0)
+    return 0;
+  return fastkst_sigsafe_format(ts.tv_sec, ts.tv_nsec, precision, buf, size);
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_SIGSAFE
+/* 빌드 방법
+gcc -DTEST_FASTKST_SIGSAFE -o fastkst_sigsafe_test fastkst_sigsafe.c fastkst_localtime.c
+./fastkst_sigsafe_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+
+int fastkst_localtime(time_t t, struct tm *tp);
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static volatile sig_atomic_t handler_calls = 0;
+static volatile sig_atomic_t handler_errno_changed = 0;
+static volatile sig_atomic_t handler_bad_text = 0;
+
+static void on_alarm(int sig)
+{
+  char ts[FASTKST_SIGSAFE_BUFSIZE];
+  int saved = errno;
+  size_t n;
+
+  (void)sig;
+  n = fastkst_sigsafe_now(ts, sizeof(ts), 6);
+  if (errno != saved)
+    handler_errno_changed++;
+  if (n != 26 || ts[4] != '-' || ts[10] != ' ' || ts[13] != ':' || ts[19] != '.' || ts[26] != '\0')
+    handler_bad_text++;
+  handler_calls++;
+}
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(void)
+{
+  char buf[FASTKST_SIGSAFE_BUFSIZE], want[64];
+  struct sigaction sa;
+  struct itimerval it;
+  struct tm tm;
+  int i, bad;
+
+  printf("=== FASTKST_SIGSAFE Test ===\n\n");
+
+  CHECK(fastkst_sigsafe_format(1767193200, 123456789, 3, buf, sizeof(buf)) == 23 &&
+        strcmp(buf, "2026-01-01 00:00:00.123") == 0, "format with milliseconds");
+  CHECK(fastkst_sigsafe_format(-62135629200 - 1, 0, 0, buf, sizeof(buf)) == 19 &&
+        strcmp(buf, "0000-12-31 23:59:59") == 0, "year 0");
+  CHECK(fastkst_sigsafe_format(-62167251600 - 1, 0, 0, buf, sizeof(buf)) == 20 &&
+        strcmp(buf, "-0001-12-31 23:59:59") == 0, "year before 0");
+  CHECK(fastkst_sigsafe_format(0, 0, 0, buf, 19) == 0 && buf[0] == '\0', "too small buffer");
+  errno = 0;
+  CHECK(fastkst_sigsafe_format(0, -1, 0, buf, sizeof(buf)) == 0 && errno == 0,
+        "bad argument reported without errno");
+
+  /* Against fastkst_localtime() */
+  bad = 0;
+  srand(88);
+  for (i = 0; i < 300000; i++) {
+    time_t t = (time_t)(((int64_t)rand() << 16 ^ rand()) % ((int64_t)8000 * 365 * 86400));
+    long ns = rand() % 1000000000L;
+    int prec = i % 10;
+    char frac[16] = "";
+
+    fastkst_localtime(t, &tm);
+    if (prec)
+      snprintf(frac, sizeof(frac), ".%09ld", ns);
+    frac[prec ? prec + 1 : 0] = '\0';
+    snprintf(want, sizeof(want), "%04d-%02d-%02d %02d:%02d:%02d%s",
+             tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+             tm.tm_hour, tm.tm_min, tm.tm_sec, frac);
+    bad += fastkst_sigsafe_format(t, ns, prec, buf, sizeof(buf)) != strlen(want) ||
+           strcmp(buf, want) != 0;
+  }
+  CHECK(bad == 0, "matches fastkst_localtime() + snprintf()");
+
+  /* SIGALRM every 50us while the main thread allocates, formats and sets errno */
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_alarm;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  sigaction(SIGALRM, &sa, NULL);
+  memset(&it, 0, sizeof(it));
+  it.it_interval.tv_usec = 50;
+  it.it_value.tv_usec = 50;
+  setitimer(ITIMER_REAL, &it, NULL);
+
+  {
+    double end = now_sec() + 0.5;
+    long loops = 0, main_errno_bad = 0;
+
+    while (now_sec() < end) {
+      char *p = malloc(64 + loops % 4096);
+      errno = (int)(loops % 1000) + 1;
+      fastkst_sigsafe_format((time_t)loops * 7919, loops % 1000000000L, 9, buf, sizeof(buf));
+      if (errno != (int)(loops % 1000) + 1)
+        main_errno_bad++;
+      snprintf(p, 64, "%ld", loops);
+      free(p);
+      loops++;
+    }
+
+    memset(&it, 0, sizeof(it));
+    setitimer(ITIMER_REAL, &it, NULL);
+    signal(SIGALRM, SIG_DFL);
+
+    printf("  %ld main loops, %d handler calls\n", loops, (int)handler_calls);
+    CHECK(handler_calls > 100, "handler ran under load");
+    CHECK(handler_errno_changed == 0 && main_errno_bad == 0, "errno untouched");
+    CHECK(handler_bad_text == 0, "handler output well formed");
+  }
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All sigsafe tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d sigsafe test(s) failed!\n", failures);
+  return 1;
+}
+#endif
@@ -0,0 +1,72 @@
+/**
+ * @file fastkst_sigsafe.h
+ * @brief Async-signal-safe KST timestamp formatting
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note Guarantee: the functions below may be called from a signal handler
+ *       (crash, watchdog, SIGALRM) at any point of the interrupted code:
+ *       - no locks, no memory allocation, no stdio, no thread-local storage
+ *       - errno is never read or written (handlers need not save it)
+ *       - no writable static state; concurrent and nested calls are fine
+ *       - the only library call is clock_gettime(CLOCK_REALTIME), which is
+ *         async-signal-safe and cannot fail with a valid clock and pointer
+ *       `make check-sigsafe` (part of `make run-test`) verifies the object
+ *       file references nothing else.
+ */
+
+#ifndef FASTKST_SIGSAFE_H
+#define FASTKST_SIGSAFE_H
+
+#include <stddef.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Buffer size that fits any output, including the NUL */
+#define FASTKST_SIGSAFE_BUFSIZE   48
+
+/**
+ * @brief Format a timestamp as "YYYY-MM-DD HH:MM:SS[.fff]" (KST)
+ * @param[in] t seconds since the epoch
+ * @param[in] nsec nanoseconds, 0..999999999
+ * @param[in] precision fraction digits, 0..9
+ * @param[out] buf output, NUL terminated
+ * @param[in] size size of buf
+ * @return size_t length written (without the NUL), 0 on bad arguments or
+ *         when buf is too small (buf[0] is then '\0' if size > 0)
+ *
+ * @note Years outside 0..9999 are written with a sign and at least four
+ *       digits ("-0001", "+10000").
+ */
+size_t fastkst_sigsafe_format(time_t t, long nsec, int precision,
+                              char *buf, size_t size);
+
+/**
+ * @brief Format the current time (CLOCK_REALTIME) like fastkst_sigsafe_format()
+ * @return size_t length written, 0 on failure
+ *
+ * @example
+ * @code
+ *   static void on_crash(int sig)
+ *   {
+ *     char ts[FASTKST_SIGSAFE_BUFSIZE];
+ *     size_t n = fastkst_sigsafe_now(ts, sizeof(ts), 3);
+ *     ts[n++] = '\n';
+ *     write(STDERR_FILENO, ts, n);
+ *     ...
+ *   }
+ * @endcode
+ */
+size_t fastkst_sigsafe_now(char *buf, size_t size, int precision);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_SIGSAFE_H */
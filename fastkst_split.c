@@ -0,0 +1,239 @@
+/**
+ * @file fastkst_split.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Split [start, end) intervals at KST minute/hour/day/week boundaries
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Test code: enabled with TEST_FASTKST_SPLIT
+ */
+#include <time.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include "fastkst_split.h"
+
+/* Emit the segments of [s, e) into out[0..cap), return how many there are */
+static size_t split_one(int64_t s, int64_t e, fastkst_unit_t unit, int64_t len,
+                        fastkst_segment_t *out, size_t cap)
+{
+  int64_t w, boundary;
+  size_t k = 0;
+
+  if (e <= s)
+    return 0;
+
+  w = fastkst_window_index((time_t)s, unit);
+  boundary = (int64_t)fastkst_window_start(w, unit) + len;
+
+  /* only the count is needed past the end of out */
+  if (cap == 0)
+    return (size_t)(fastkst_window_index((time_t)(e - 1), unit) - w + 1);
+
+  for (;;) {
+    int64_t piece_end = boundary < e ? boundary : e;
+
+    if (k < cap) {
+      out[k].start = (time_t)s;
+      out[k].end = (time_t)piece_end;
+      out[k].window = w;
+    }
+    k++;
+    if (piece_end == e)
+      return k;
+    if (k == cap)
+      return k + (size_t)(fastkst_window_index((time_t)(e - 1), unit) - w);
+    s = boundary;
+    boundary += len;
+    w++;
+  }
+}
+
+size_t fastkst_split_interval(time_t start, time_t end, fastkst_unit_t unit,
+                              fastkst_segment_t *out, size_t cap)
+{
+  int64_t len = fastkst_unit_seconds(unit);
+
+  if (len == 0 || (cap > 0 && out == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+  return split_one(start, end, unit, len, out, cap);
+}
+
+size_t fastkst_split_intervals(const time_t *start, const time_t *end, size_t n,
+                               fastkst_unit_t unit, fastkst_segment_t *out,
+                               size_t cap, size_t *first_seg)
+{
+  int64_t len = fastkst_unit_seconds(unit);
+  size_t total = 0;
+  size_t i;
+
+  if (len == 0 || (n > 0 && (start == NULL || end == NULL)) || (cap > 0 && out == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (first_seg)
+      first_seg[i] = total;
+    total += split_one(start[i], end[i], unit, len,
+                       total < cap ? out + total : NULL,
+                       total < cap ? cap - total : 0);
+  }
+  if (first_seg)
+    first_seg[n] = total;
+  return total;
+}
+
+int64_t fastkst_split_accumulate(const time_t *start, const time_t *end,
+                                 const int64_t *weight, size_t n,
+                                 fastkst_unit_t unit, int64_t first_window,
+                                 int64_t *totals, size_t nwindows)
+{
+  int64_t len = fastkst_unit_seconds(unit);
+  int64_t lo, hi;
+  int64_t dropped = 0;
+  size_t i;
+
+  if (len == 0 || (n > 0 && (start == NULL || end == NULL)) ||
+      (nwindows > 0 && totals == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  lo = (int64_t)fastkst_window_start(first_window, unit);
+  hi = lo + (int64_t)nwindows * len;
+
+  for (i = 0; i < n; i++) {
+    int64_t wt = weight ? weight[i] : 1;
+    int64_t s = start[i], e = end[i];
+    int64_t cs, ce, k, boundary;
+
+    if (e <= s)
+      continue;
+
+    /* clip to the covered range; the rest is reported, not looped over */
+    cs = s < lo ? lo : s;
+    ce = e > hi ? hi : e;
+    if (ce <= cs) {
+      dropped += (e - s) * wt;
+      continue;
+    }
+    dropped += ((cs - s) + (e - ce)) * wt;
+
+    k = (cs - lo) / len;
+    boundary = lo + (k + 1) * len;
+    while (boundary < ce) {
+      totals[k] += (boundary - cs) * wt;
+      cs = boundary;
+      boundary += len;
+      k++;
+    }
+    totals[k] += (ce - cs) * wt;
+  }
+  return dropped;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_SPLIT
+/* 빌드 방법
+gcc -DTEST_FASTKST_SPLIT -o fastkst_split_test fastkst_split.c fastkst_calendar.c fastkst_localtime.c
+./fastkst_split_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+int main(void)
+{
+  /* 2025-12-31 22:30:00 KST .. 2026-01-02 01:15:00 KST */
+  const time_t s = 1767187800, e = 1767284100;
+  const time_t midnight1 = 1767193200, midnight2 = 1767279600;
+  fastkst_segment_t seg[8];
+  size_t n;
+
+  printf("=== FASTKST_SPLIT Test ===\n\n");
+
+  n = fastkst_split_interval(s, e, FASTKST_UNIT_DAY, seg, 8);
+  CHECK(n == 3 &&
+        seg[0].start == s && seg[0].end == midnight1 &&
+        seg[1].start == midnight1 && seg[1].end == midnight2 &&
+        seg[2].start == midnight2 && seg[2].end == e &&
+        seg[1].window == seg[0].window + 1, "split at KST midnights");
+
+  n = fastkst_split_interval(s, e, FASTKST_UNIT_HOUR, seg, 2);
+  CHECK(n == 28 && seg[1].start == s + 1800 && seg[1].end == s + 5400,
+        "hour split reports full count when out is small");
+  CHECK(fastkst_split_interval(s, e, FASTKST_UNIT_HOUR, NULL, 0) == 28, "count only");
+  CHECK(fastkst_split_interval(s, s, FASTKST_UNIT_DAY, seg, 8) == 0, "empty interval");
+  CHECK(fastkst_split_interval(midnight1, midnight2, FASTKST_UNIT_DAY, seg, 8) == 1,
+        "interval exactly one KST day");
+
+  /* Array form with offsets */
+  {
+    time_t st[3] = { s, midnight1 + 10, midnight1 - 1 };
+    time_t en[3] = { e, midnight1 + 20, midnight1 + 1 };
+    size_t first[4];
+
+    n = fastkst_split_intervals(st, en, 3, FASTKST_UNIT_DAY, seg, 8, first);
+    CHECK(n == 6 && first[0] == 0 && first[1] == 3 && first[2] == 4 && first[3] == 6 &&
+          seg[4].end == midnight1 && seg[5].start == midnight1, "array split with offsets");
+  }
+
+  /* Accumulate against a per-second reference */
+  {
+    enum { NI = 2000, NW = 40 };
+    static time_t st[NI], en[NI];
+    static int64_t wt[NI];
+    int64_t totals[NW] = { 0 }, ref[NW] = { 0 };
+    int64_t first = fastkst_window_index(midnight1, FASTKST_UNIT_HOUR);
+    int64_t dropped, ref_dropped = 0;
+    int i, bad = 0;
+
+    srand(77);
+    for (i = 0; i < NI; i++) {
+      st[i] = midnight1 - 3600 + rand() % (50 * 3600);
+      en[i] = st[i] + rand() % (5 * 3600);
+      wt[i] = 1 + rand() % 4;
+    }
+    dropped = fastkst_split_accumulate(st, en, wt, NI, FASTKST_UNIT_HOUR, first, totals, NW);
+
+    for (i = 0; i < NI; i++) {
+      time_t t;
+      for (t = st[i]; t < en[i]; t++) {
+        int64_t k = fastkst_window_index(t, FASTKST_UNIT_HOUR) - first;
+        if (k >= 0 && k < NW)
+          ref[k] += wt[i];
+        else
+          ref_dropped += wt[i];
+      }
+    }
+    for (i = 0; i < NW; i++)
+      bad += totals[i] != ref[i];
+    CHECK(bad == 0 && dropped == ref_dropped, "accumulate matches per-second reference");
+  }
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All split tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d split test(s) failed!\n", failures);
+  return 1;
+}
+#endif
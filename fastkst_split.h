@@ -0,0 +1,91 @@
+/**
+ * @file fastkst_split.h
+ * @brief Split [start, end) intervals at KST minute/hour/day/week boundaries
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - For metered billing: each usage interval is cut into pieces that do not
+ *    cross a KST window boundary, either as a segment array or accumulated
+ *    into per-window totals.
+ *  - The first boundary comes from fastkst_window_index() (+9 arithmetic);
+ *    the following ones are one unit apart, so the cost is proportional to
+ *    the number of boundaries crossed.
+ */
+
+#ifndef FASTKST_SPLIT_H
+#define FASTKST_SPLIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "fastkst_calendar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One boundary-aligned piece of an interval
+ */
+typedef struct {
+  time_t start;       /**< inclusive */
+  time_t end;         /**< exclusive */
+  int64_t window;     /**< fastkst_window_index() of the piece */
+} fastkst_segment_t;
+
+/**
+ * @brief Split one interval
+ * @param[in] start interval start (inclusive)
+ * @param[in] end interval end (exclusive); end <= start gives no segment
+ * @param[in] unit boundary unit
+ * @param[out] out segments (can be NULL when cap is 0)
+ * @param[in] cap capacity of out
+ * @return size_t number of segments of the interval; only the first cap are
+ *         written, so a return value > cap means out was too small
+ */
+size_t fastkst_split_interval(time_t start, time_t end, fastkst_unit_t unit,
+                              fastkst_segment_t *out, size_t cap);
+
+/**
+ * @brief Split an array of intervals into one segment array
+ * @param[in] start interval starts
+ * @param[in] end interval ends
+ * @param[in] n number of intervals
+ * @param[in] unit boundary unit
+ * @param[out] out segments of all intervals, in input order
+ * @param[in] cap capacity of out
+ * @param[out] first_seg n + 1 offsets: segments of interval i are
+ *             out[first_seg[i] .. first_seg[i + 1]) (optional, can be NULL)
+ * @return size_t total number of segments; > cap means out was too small
+ */
+size_t fastkst_split_intervals(const time_t *start, const time_t *end, size_t n,
+                               fastkst_unit_t unit, fastkst_segment_t *out,
+                               size_t cap, size_t *first_seg);
+
+/**
+ * @brief Accumulate interval durations into per-window totals
+ * @param[in] start interval starts
+ * @param[in] end interval ends
+ * @param[in] weight per-interval multiplier (e.g. units in use), NULL for 1
+ * @param[in] n number of intervals
+ * @param[in] unit window unit
+ * @param[in] first_window window index of totals[0]
+ * @param[in,out] totals per-window sums of seconds * weight (added to)
+ * @param[in] nwindows number of windows in totals
+ * @return int64_t seconds * weight falling outside the covered windows (not added)
+ */
+int64_t fastkst_split_accumulate(const time_t *start, const time_t *end,
+                                 const int64_t *weight, size_t n,
+                                 fastkst_unit_t unit, int64_t first_window,
+                                 int64_t *totals, size_t nwindows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_SPLIT_H */
@@ -0,0 +1,583 @@
+/**
+ * @file fastkst_timerwheel.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Hierarchical timer wheel keyed on epoch seconds, aligned to KST boundaries
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - A timer lives on the level of the highest 6-bit digit in which its
+ *    deadline differs from w->now, in the slot named by that digit. When
+ *    w->now reaches a multiple of 64^L, the slot of level L for the new digit
+ *    is cascaded into the lower levels, so every timer fires on its exact second.
+ *  - Empty stretches are skipped with the occupancy bitmaps, so advancing
+ *    over an idle period costs one step per occupied slot, not per second.
+ *  - Test code: enabled with TEST_FASTKST_TIMERWHEEL
+ */
+#include <time.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+#include "fastkst_timerwheel.h"
+
+#define TW_MASK       ((uint64_t)FASTKST_TW_SLOTS - 1)
+#define TW_TOP_SHIFT  (FASTKST_TW_LEVELS * FASTKST_TW_SLOT_BITS)
+#define SLOT_NONE     (-1)
+#define SLOT_OVERFLOW (-2)
+#define SLOT_PENDING  (-3)    /* spliced out for expiry, callback not run yet */
+
+static void link_timer(fastkst_timer_t **head, fastkst_timer_t *timer)
+{
+  timer->next = *head;
+  if (*head)
+    (*head)->pprev = &timer->next;
+  *head = timer;
+  timer->pprev = head;
+}
+
+static void unlink_timer(fastkst_timer_t *timer)
+{
+  *timer->pprev = timer->next;
+  if (timer->next)
+    timer->next->pprev = timer->pprev;
+  timer->next = NULL;
+  timer->pprev = NULL;
+}
+
+static void place(fastkst_timerwheel_t *w, fastkst_timer_t *timer)
+{
+  uint64_t n = (uint64_t)w->now;
+  uint64_t e = (uint64_t)timer->expires;
+  uint64_t diff;
+  int level, slot;
+
+  if (timer->expires < w->now)
+    e = n;
+  diff = e ^ n;
+  level = diff == 0 ? 0 : (63 - __builtin_clzll(diff)) / FASTKST_TW_SLOT_BITS;
+
+  if (level >= FASTKST_TW_LEVELS) {
+    timer->slot_id = SLOT_OVERFLOW;
+    link_timer(&w->overflow, timer);
+    return;
+  }
+
+  slot = (int)((e >> (level * FASTKST_TW_SLOT_BITS)) & TW_MASK);
+  timer->slot_id = level * FASTKST_TW_SLOTS + slot;
+  link_timer(&w->slots[level][slot], timer);
+  w->occupied[level] |= 1ULL << slot;
+}
+
+/* Move every timer of a list back through place() */
+static void replace_list(fastkst_timerwheel_t *w, fastkst_timer_t *list)
+{
+  while (list) {
+    fastkst_timer_t *next = list->next;
+
+    list->next = NULL;
+    list->pprev = NULL;
+    place(w, list);
+    list = next;
+  }
+}
+
+/* w->now has just become a multiple of 64 */
+static void cascade(fastkst_timerwheel_t *w)
+{
+  uint64_t n = (uint64_t)w->now;
+  int level;
+
+  for (level = 1; level < FASTKST_TW_LEVELS; level++) {
+    int digit = (int)((n >> (level * FASTKST_TW_SLOT_BITS)) & TW_MASK);
+    fastkst_timer_t *list = w->slots[level][digit];
+
+    w->slots[level][digit] = NULL;
+    w->occupied[level] &= ~(1ULL << digit);
+    replace_list(w, list);
+
+    if (digit != 0)
+      return;
+  }
+
+  /* top level wrapped: pull in whatever is now within range */
+  if (w->overflow) {
+    fastkst_timer_t *list = w->overflow;
+
+    w->overflow = NULL;
+    replace_list(w, list);
+  }
+}
+
+int fastkst_timerwheel_init(fastkst_timerwheel_t *w, time_t now)
+{
+  if (w == NULL || now < 0) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  memset(w, 0, sizeof(*w));
+  w->now = now;
+  w->fd = -1;
+  return 1;
+}
+
+void fastkst_timer_init(fastkst_timer_t *timer, fastkst_timer_fn fn, void *arg)
+{
+  memset(timer, 0, sizeof(*timer));
+  timer->slot_id = SLOT_NONE;
+  timer->fn = fn;
+  timer->arg = arg;
+}
+
+int fastkst_timerwheel_cancel(fastkst_timerwheel_t *w, fastkst_timer_t *timer)
+{
+  fastkst_timer_t **head;
+  int id;
+
+  if (w == NULL || timer == NULL || timer->pprev == NULL)
+    return 0;
+
+  id = timer->slot_id;
+  unlink_timer(timer);
+  timer->slot_id = SLOT_NONE;
+  w->count--;
+
+  if (id >= 0) {
+    head = &w->slots[id / FASTKST_TW_SLOTS][id % FASTKST_TW_SLOTS];
+    if (*head == NULL)
+      w->occupied[id / FASTKST_TW_SLOTS] &= ~(1ULL << (id % FASTKST_TW_SLOTS));
+  }
+  return 1;
+}
+
+int fastkst_timerwheel_add(fastkst_timerwheel_t *w, fastkst_timer_t *timer,
+                           time_t expires)
+{
+  if (w == NULL || timer == NULL || timer->fn == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  fastkst_timerwheel_cancel(w, timer);
+  timer->expires = expires;
+  place(w, timer);
+  w->count++;
+  return 1;
+}
+
+int fastkst_timerwheel_add_aligned(fastkst_timerwheel_t *w, fastkst_timer_t *timer,
+                                   fastkst_unit_t unit, int64_t phase, int periodic)
+{
+  time_t expires;
+
+  if (w == NULL || timer == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  /* w->now itself has not been processed yet, so it is a valid boundary */
+  expires = fastkst_next_boundary(w->now - 1, unit, phase);
+  if (expires == (time_t)-1)
+    return 0;
+
+  timer->periodic = periodic;
+  timer->unit = unit;
+  timer->phase = phase;
+  return fastkst_timerwheel_add(w, timer, expires);
+}
+
+/* Run the timers of level 0 slot, due at second w->now */
+static size_t expire_slot(fastkst_timerwheel_t *w, int slot, time_t target)
+{
+  fastkst_timer_t *pending = w->slots[0][slot];
+  fastkst_timer_t *timer;
+  size_t fired = 0;
+
+  w->slots[0][slot] = NULL;
+  w->occupied[0] &= ~(1ULL << slot);
+  if (pending == NULL)
+    return 0;
+
+  /* re-home the list so that callbacks can cancel timers still pending */
+  pending->pprev = &pending;
+  for (timer = pending; timer; timer = timer->next)
+    timer->slot_id = SLOT_PENDING;
+
+  while ((timer = pending) != NULL) {
+    unlink_timer(timer);
+    timer->slot_id = SLOT_NONE;
+    w->count--;
+
+    /* missed boundaries are coalesced into a single callback */
+    if (timer->periodic) {
+      time_t base = timer->expires > target ? timer->expires : target;
+
+      timer->expires = fastkst_next_boundary(base, timer->unit, timer->phase);
+      place(w, timer);
+      w->count++;
+    }
+
+    timer->fn(timer, timer->arg);
+    fired++;
+  }
+  return fired;
+}
+
+size_t fastkst_timerwheel_advance(fastkst_timerwheel_t *w, time_t now)
+{
+  size_t fired = 0;
+
+  if (w == NULL)
+    return 0;
+
+  while (w->now <= now) {
+    uint64_t idx = (uint64_t)w->now & TW_MASK;
+    uint64_t bits = w->occupied[0] >> idx;
+
+    if (bits == 0) {
+      /* nothing due in this rotation: jump to the next occupied cascade point */
+      time_t next = fastkst_timerwheel_next_wakeup(w);
+
+      if (next == (time_t)-1 || next > now + 1) {
+        w->now = now + 1;
+        break;
+      }
+      w->now = next;
+      cascade(w);
+      continue;
+    }
+
+    w->now += __builtin_ctzll(bits);
+    if (w->now > now) {
+      w->now = now + 1;
+      break;
+    }
+
+    /* callbacks may arm timers for the current second: run those too */
+    while (w->occupied[0] & (1ULL << ((uint64_t)w->now & TW_MASK)))
+      fired += expire_slot(w, (int)((uint64_t)w->now & TW_MASK), now);
+    w->now++;
+    if (((uint64_t)w->now & TW_MASK) == 0)
+      cascade(w);
+  }
+  return fired;
+}
+
+time_t fastkst_timerwheel_next_wakeup(const fastkst_timerwheel_t *w)
+{
+  uint64_t n;
+  int level;
+
+  if (w == NULL || w->count == 0)
+    return (time_t)-1;
+
+  n = (uint64_t)w->now;
+  for (level = 0; level < FASTKST_TW_LEVELS; level++) {
+    int shift = level * FASTKST_TW_SLOT_BITS;
+    int digit = (int)((n >> shift) & TW_MASK);
+    uint64_t mask;
+    uint64_t bits;
+
+    /* level 0 includes the current second; upper levels never use it */
+    if (level == 0)
+      mask = ~0ULL << digit;
+    else
+      mask = digit == (int)TW_MASK ? 0 : ~0ULL << (digit + 1);
+
+    bits = w->occupied[level] & mask;
+    if (bits) {
+      uint64_t base = (n >> (shift + FASTKST_TW_SLOT_BITS)) << (shift + FASTKST_TW_SLOT_BITS);
+
+      return (time_t)(base + ((uint64_t)__builtin_ctzll(bits) << shift));
+    }
+  }
+
+  return (time_t)(((n >> TW_TOP_SHIFT) + 1) << TW_TOP_SHIFT);
+}
+
+int fastkst_timerwheel_open_fd(fastkst_timerwheel_t *w)
+{
+  if (w == NULL) {
+    errno = EINVAL;
+    return -1;
+  }
+  if (w->fd < 0)
+    w->fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+  return w->fd;
+}
+
+int fastkst_timerwheel_rearm(fastkst_timerwheel_t *w)
+{
+  struct itimerspec its;
+  time_t next;
+
+  if (w == NULL || w->fd < 0) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  memset(&its, 0, sizeof(its));
+  next = fastkst_timerwheel_next_wakeup(w);
+  if (next != (time_t)-1)
+    its.it_value.tv_sec = next;   /* zero it_value disarms */
+
+  return timerfd_settime(w->fd, TFD_TIMER_ABSTIME, &its, NULL) == 0;
+}
+
+size_t fastkst_timerwheel_dispatch(fastkst_timerwheel_t *w)
+{
+  struct timespec ts;
+  uint64_t expirations;
+  size_t fired;
+
+  if (w == NULL || w->fd < 0)
+    return 0;
+
+  /* drain; EAGAIN just means a spurious wakeup */
+  if (read(w->fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+    return 0;
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+  fired = fastkst_timerwheel_advance(w, ts.tv_sec);
+  fastkst_timerwheel_rearm(w);
+  return fired;
+}
+
+void fastkst_timerwheel_close_fd(fastkst_timerwheel_t *w)
+{
+  if (w != NULL && w->fd >= 0) {
+    close(w->fd);
+    w->fd = -1;
+  }
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_TIMERWHEEL
+/* 빌드 방법
+gcc -DTEST_FASTKST_TIMERWHEEL -o fastkst_timerwheel_test fastkst_timerwheel.c fastkst_calendar.c fastkst_localtime.c
+./fastkst_timerwheel_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <poll.h>
+#include <sys/time.h>
+
+#define NUM_TIMERS 200000
+
+typedef struct {
+  fastkst_timer_t timer;
+  time_t want;
+  time_t fired_at;
+  int fired;
+  int late;
+  int cancelled;
+} test_timer_t;
+
+static time_t current_target;
+static time_t previous_target;
+
+static void on_fire(fastkst_timer_t *timer, void *arg)
+{
+  test_timer_t *tt = (test_timer_t *)arg;
+
+  (void)timer;
+  tt->fired++;
+  tt->fired_at = current_target;
+  /* due in an earlier advance() step but fired only now */
+  if (tt->want <= previous_target)
+    tt->late = 1;
+}
+
+static int daily_fires = 0;
+static time_t daily_last = 0;
+
+static void on_daily(fastkst_timer_t *timer, void *arg)
+{
+  (void)arg;
+  daily_fires++;
+  daily_last = timer->expires;    /* already re-armed: the next boundary */
+}
+
+static double get_time_usec(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec * 1000000.0 + (double)tv.tv_usec;
+}
+
+int main(void)
+{
+  static fastkst_timerwheel_t w;
+  static test_timer_t timers[NUM_TIMERS];
+  fastkst_timer_t daily;
+  const time_t start = 1767153165;    /* 2025-12-31 12:52:45 KST */
+  int failures = 0;
+  int i;
+  double t0, t1;
+
+  printf("=== FASTKST_TIMERWHEEL Test ===\n\n");
+
+  fastkst_timerwheel_init(&w, start);
+  srand(4242);
+
+  t0 = get_time_usec();
+  for (i = 0; i < NUM_TIMERS; i++) {
+    int64_t span = (i % 4 == 0) ? 90 : (i % 4 == 1) ? 86400 * 3 : (i % 4 == 2) ? 86400 * 400 : (1LL << 31);
+
+    timers[i].want = start - 5 + (time_t)((((int64_t)rand() << 16) ^ rand()) % span);
+    fastkst_timer_init(&timers[i].timer, on_fire, &timers[i]);
+    fastkst_timerwheel_add(&w, &timers[i].timer, timers[i].want);
+  }
+  for (i = 0; i < NUM_TIMERS; i += 3) {
+    timers[i].cancelled = 1;
+    fastkst_timerwheel_cancel(&w, &timers[i].timer);
+  }
+  t1 = get_time_usec();
+  printf("Insert %d + cancel %d: %.3f microseconds/op\n", NUM_TIMERS, NUM_TIMERS / 3,
+         (t1 - t0) / (NUM_TIMERS + NUM_TIMERS / 3));
+
+  /* Calendar timer: every KST midnight */
+  fastkst_timer_init(&daily, on_daily, NULL);
+  fastkst_timerwheel_add_aligned(&w, &daily, FASTKST_UNIT_DAY, 0, 1);
+  if (daily.expires != 1767193200) {   /* 2026-01-01 00:00:00 KST */
+    printf("[FAIL] next KST midnight: %lld\n", (long long)daily.expires);
+    failures++;
+  }
+
+  /* Advance with irregular steps, checking next_wakeup never overshoots */
+  t0 = get_time_usec();
+  previous_target = 0;    /* deadlines before start are all due in the first step */
+  current_target = start;
+  while (current_target < start + (1LL << 31) + 10) {
+    time_t wake = fastkst_timerwheel_next_wakeup(&w);
+
+    if (wake != (time_t)-1 && wake < w.now) {
+      printf("[FAIL] next_wakeup %lld before now %lld\n", (long long)wake, (long long)w.now);
+      failures++;
+      break;
+    }
+    fastkst_timerwheel_advance(&w, current_target);
+    previous_target = current_target;
+    if (current_target < start + 86400 * 10)
+      current_target += 1 + rand() % 700;
+    else
+      current_target += 1 + rand() % 40000000;
+  }
+  fastkst_timerwheel_advance(&w, current_target);
+  t1 = get_time_usec();
+  printf("Advance through ~68 years: %.3f ms\n", (t1 - t0) / 1000.0);
+
+  /* every timer fired exactly once, in the advance() step covering its deadline */
+  {
+    int bad = 0;
+    for (i = 0; i < NUM_TIMERS; i++) {
+      test_timer_t *tt = &timers[i];
+      if (tt->cancelled) {
+        if (tt->fired) bad++;
+        continue;
+      }
+      if (tt->fired != 1) {
+        bad++;
+        continue;
+      }
+      if (tt->fired_at < tt->want || tt->late)
+        bad++;
+    }
+    if (bad) {
+      printf("[FAIL] %d timers fired incorrectly\n", bad);
+      failures++;
+    } else {
+      printf("[PASS] all timers fired once, on time, cancelled ones never\n");
+    }
+  }
+
+  /* Exact-second check with one-second steps */
+  fastkst_timerwheel_init(&w, start);
+  for (i = 0; i < 1000; i++) {
+    timers[i].want = start + 60 + (i * 7919) % 10000;
+    timers[i].fired = 0;
+    fastkst_timer_init(&timers[i].timer, on_fire, &timers[i]);
+    fastkst_timerwheel_add(&w, &timers[i].timer, timers[i].want);
+  }
+  for (current_target = start; current_target <= start + 10100; current_target++) {
+    previous_target = current_target - 1;
+    fastkst_timerwheel_advance(&w, current_target);
+  }
+  {
+    int bad = 0;
+    for (i = 0; i < 1000; i++)
+      if (timers[i].fired != 1 || timers[i].fired_at != timers[i].want)
+        bad++;
+    if (bad) {
+      printf("[FAIL] %d timers not fired on their exact second\n", bad);
+      failures++;
+    } else {
+      printf("[PASS] one-second stepping fires on the exact second\n");
+    }
+  }
+
+  /* Periodic midnight timer over 10 days, and coalescing after a jump */
+  fastkst_timerwheel_init(&w, start);
+  daily_fires = 0;
+  fastkst_timer_init(&daily, on_daily, NULL);
+  fastkst_timerwheel_add_aligned(&w, &daily, FASTKST_UNIT_DAY, 0, 1);
+  for (current_target = start; current_target < start + 10 * 86400; current_target += 600)
+    fastkst_timerwheel_advance(&w, current_target);
+  if (daily_fires != 10 || daily_last != 1767193200 + 10 * 86400) {
+    printf("[FAIL] periodic midnight fired %d times\n", daily_fires);
+    failures++;
+  } else {
+    printf("[PASS] periodic midnight timer\n");
+  }
+  daily_fires = 0;
+  fastkst_timerwheel_advance(&w, current_target + 30 * 86400);
+  if (daily_fires != 1 || daily.expires <= current_target + 30 * 86400) {
+    printf("[FAIL] missed boundaries not coalesced (%d)\n", daily_fires);
+    failures++;
+  } else {
+    printf("[PASS] missed boundaries coalesced\n");
+  }
+  fastkst_timerwheel_cancel(&w, &daily);
+
+  /* timerfd driven: a timer one second from now */
+  {
+    struct timespec ts;
+    struct pollfd pfd;
+    int got = 0, tries;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    fastkst_timerwheel_init(&w, ts.tv_sec);
+    timers[0].fired = 0;
+    fastkst_timer_init(&timers[0].timer, on_fire, &timers[0]);
+    fastkst_timerwheel_add(&w, &timers[0].timer, ts.tv_sec + 1);
+
+    pfd.fd = fastkst_timerwheel_open_fd(&w);
+    pfd.events = POLLIN;
+    fastkst_timerwheel_rearm(&w);
+    for (tries = 0; tries < 5 && !got; tries++) {
+      if (poll(&pfd, 1, 1000) > 0)
+        got += (int)fastkst_timerwheel_dispatch(&w);
+    }
+    fastkst_timerwheel_close_fd(&w);
+    if (got != 1 || timers[0].fired != 1) {
+      printf("[FAIL] timerfd dispatch\n");
+      failures++;
+    } else {
+      printf("[PASS] timerfd dispatch\n");
+    }
+  }
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All timer wheel tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d timer wheel test(s) failed!\n", failures);
+  return 1;
+}
+#endif
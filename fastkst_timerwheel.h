@@ -0,0 +1,151 @@
+/**
+ * @file fastkst_timerwheel.h
+ * @brief Hierarchical timer wheel keyed on epoch seconds, aligned to KST boundaries
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - One-second resolution, 5 levels of 64 slots (about 34 years) plus an
+ *    overflow list. Insert and cancel are O(1); expiry splices a whole slot.
+ *  - Calendar timers ("next KST midnight", "every Monday 09:00") compute
+ *    their deadlines with fastkst_next_boundary() and re-arm themselves.
+ *  - The whole wheel is driven by a single timerfd (CLOCK_REALTIME,
+ *    TFD_TIMER_ABSTIME), so wall clock jumps are followed automatically.
+ *  - Not thread-safe: one wheel belongs to one event loop thread.
+ */
+
+#ifndef FASTKST_TIMERWHEEL_H
+#define FASTKST_TIMERWHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "fastkst_calendar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FASTKST_TW_LEVELS     5
+#define FASTKST_TW_SLOT_BITS  6
+#define FASTKST_TW_SLOTS      (1 << FASTKST_TW_SLOT_BITS)
+
+typedef struct fastkst_timer fastkst_timer_t;
+typedef void (*fastkst_timer_fn)(fastkst_timer_t *timer, void *arg);
+
+/**
+ * @brief Timer entry, embedded in (or allocated by) the caller
+ */
+struct fastkst_timer {
+  fastkst_timer_t *next;        /**< slot list link */
+  fastkst_timer_t **pprev;      /**< NULL when not armed */
+  int slot_id;                  /**< level * FASTKST_TW_SLOTS + slot, or < 0 */
+  time_t expires;               /**< deadline, UTC epoch seconds */
+  fastkst_timer_fn fn;          /**< callback */
+  void *arg;                    /**< callback argument */
+  int periodic;                 /**< re-arm at the next calendar boundary */
+  fastkst_unit_t unit;          /**< calendar unit of a periodic timer */
+  int64_t phase;                /**< seconds into the unit */
+};
+
+/**
+ * @brief Timer wheel
+ */
+typedef struct {
+  time_t now;                                              /**< next second to process */
+  uint64_t occupied[FASTKST_TW_LEVELS];                    /**< non-empty slot bitmaps */
+  fastkst_timer_t *slots[FASTKST_TW_LEVELS][FASTKST_TW_SLOTS];
+  fastkst_timer_t *overflow;                               /**< beyond the top level */
+  size_t count;                                            /**< armed timers */
+  int fd;                                                  /**< timerfd, -1 if none */
+} fastkst_timerwheel_t;
+
+/**
+ * @brief Initialise a wheel
+ * @param[out] w wheel
+ * @param[in] now current time; timers due at or before now fire on the next advance
+ * @return int 1 on success, 0 on failure (EINVAL)
+ */
+int fastkst_timerwheel_init(fastkst_timerwheel_t *w, time_t now);
+
+/**
+ * @brief Initialise a timer entry
+ */
+void fastkst_timer_init(fastkst_timer_t *timer, fastkst_timer_fn fn, void *arg);
+
+/**
+ * @brief Arm a one-shot timer at an absolute time (re-arms if already armed)
+ * @return int 1 on success, 0 on failure (EINVAL)
+ */
+int fastkst_timerwheel_add(fastkst_timerwheel_t *w, fastkst_timer_t *timer,
+                           time_t expires);
+
+/**
+ * @brief Arm a timer at the next KST calendar boundary
+ * @param[in] w wheel
+ * @param[in] timer timer entry
+ * @param[in] unit boundary unit
+ * @param[in] phase seconds into the unit (e.g. DAY with 0 = midnight,
+ *                  WEEK with 9 * 3600 = Monday 09:00)
+ * @param[in] periodic non-zero to re-arm at the following boundary after firing
+ * @return int 1 on success, 0 on failure (EINVAL)
+ */
+int fastkst_timerwheel_add_aligned(fastkst_timerwheel_t *w, fastkst_timer_t *timer,
+                                   fastkst_unit_t unit, int64_t phase, int periodic);
+
+/**
+ * @brief Disarm a timer
+ * @return int 1 if the timer was armed, 0 otherwise
+ */
+int fastkst_timerwheel_cancel(fastkst_timerwheel_t *w, fastkst_timer_t *timer);
+
+/**
+ * @brief Fire every timer with expires <= now
+ * @param[in] w wheel
+ * @param[in] now current time
+ * @return size_t number of callbacks run
+ *
+ * @note Callbacks may add, re-arm or cancel any timer, including their own.
+ */
+size_t fastkst_timerwheel_advance(fastkst_timerwheel_t *w, time_t now);
+
+/**
+ * @brief Earliest time the wheel needs to be advanced
+ * @return time_t exact next expiry for timers due within 64 seconds, otherwise
+ *         the next cascade point (never later than the next expiry);
+ *         (time_t)-1 when no timer is armed
+ */
+time_t fastkst_timerwheel_next_wakeup(const fastkst_timerwheel_t *w);
+
+/**
+ * @brief Create the timerfd driving the wheel
+ * @return int the file descriptor (poll for POLLIN), -1 on failure (errno set)
+ */
+int fastkst_timerwheel_open_fd(fastkst_timerwheel_t *w);
+
+/**
+ * @brief Program the timerfd for fastkst_timerwheel_next_wakeup()
+ * @return int 1 on success, 0 on failure (errno set)
+ */
+int fastkst_timerwheel_rearm(fastkst_timerwheel_t *w);
+
+/**
+ * @brief Handle a readable timerfd: advance to CLOCK_REALTIME and re-arm
+ * @return size_t number of callbacks run
+ */
+size_t fastkst_timerwheel_dispatch(fastkst_timerwheel_t *w);
+
+/**
+ * @brief Close the timerfd (armed timers are left untouched)
+ */
+void fastkst_timerwheel_close_fd(fastkst_timerwheel_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_TIMERWHEEL_H */
@@ -0,0 +1,408 @@
+/**
+ * @file fastkst_validate.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Bulk validation and normalisation of broken-down KST times
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Normalisation: seconds, minutes and hours are carried with floor
+ *    division, months fold into the year, and the day overflow is resolved
+ *    by going through the epoch day (fastkst_days_from_civil() and back).
+ *  - Test code: enabled with TEST_FASTKST_VALIDATE
+ */
+#define _GNU_SOURCE
+#include <time.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+
+#include "fastkst_validate.h"
+#include "fastkst_internal.h"
+
+typedef struct {
+  int64_t year;               /* tm_year */
+  int64_t mon, mday, hour, min, sec;
+  int64_t wday, yday;
+} row_t;
+
+/* __isleap() without short-circuit operators */
+static inline unsigned leap_of(int64_t y)
+{
+  return ((y & 3) == 0) & ((y % 100 != 0) | (y % 400 == 0));
+}
+
+static inline uint8_t check_row(int64_t year, int32_t mon, int32_t mday,
+                                int32_t hour, int32_t min, int32_t sec)
+{
+  unsigned mon_ok = (uint32_t)mon <= 11;
+  unsigned idx = (uint32_t)mon & (0u - mon_ok);       /* 0 when mon is bad */
+  const unsigned short int *ip = __mon_yday[leap_of(year + 1900)];
+  uint32_t mlen = (uint32_t)(ip[idx + 1] - ip[idx]);
+
+  return (uint8_t)((!mon_ok) * FASTKST_TM_BAD_MON |
+                   ((uint32_t)mday - 1u >= mlen) * FASTKST_TM_BAD_MDAY |
+                   ((uint32_t)hour > 23) * FASTKST_TM_BAD_HOUR |
+                   ((uint32_t)min > 59) * FASTKST_TM_BAD_MIN |
+                   ((uint32_t)sec > 60) * FASTKST_TM_BAD_SEC);
+}
+
+/* Carry every field into range; returns 0 if the year leaves tm_year */
+static inline int normalize_row(const row_t *in, row_t *out)
+{
+  int64_t c, y, days;
+  int m, d;
+
+  out->sec = in->sec;
+  c = fastkst_floor_div(out->sec, 60);
+  out->sec -= c * 60;
+  out->min = in->min + c;
+  c = fastkst_floor_div(out->min, 60);
+  out->min -= c * 60;
+  out->hour = in->hour + c;
+  c = fastkst_floor_div(out->hour, 24);
+  out->hour -= c * 24;
+
+  y = in->year + 1900 + fastkst_floor_div(in->mon, 12);
+  m = (int)(in->mon - fastkst_floor_div(in->mon, 12) * 12);
+  days = fastkst_days_from_civil(y, m + 1, 1) + in->mday - 1 + c;
+
+  fastkst_civil_from_days(days, &y, &m, &d);
+  out->year = y - 1900;
+  out->mon = m - 1;
+  out->mday = d;
+  out->yday = days - fastkst_days_from_civil(y, 1, 1);
+  out->wday = fastkst_floor_div(days + 4, 7) * -7 + days + 4;   /* Jan 1, 1970: Thursday */
+
+  return (out->year >= INT_MIN) & (out->year <= INT_MAX);
+}
+
+static inline unsigned row_differs(const row_t *a, const row_t *b)
+{
+  return (a->year != b->year) | (a->mon != b->mon) | (a->mday != b->mday) |
+         (a->hour != b->hour) | (a->min != b->min) | (a->sec != b->sec);
+}
+
+/* Accumulate one bit per row and store a word every 64 rows */
+#define BITMAP_PUT(map, word, i, n, bit)                       \
+  do {                                                         \
+    (word) |= (uint64_t)(bit) << ((i) & 63);                   \
+    if (((i) & 63) == 63 || (i) + 1 == (n)) {                  \
+      if (map)                                                 \
+        (map)[(i) >> 6] = (word);                              \
+      (word) = 0;                                              \
+    }                                                          \
+  } while (0)
+
+size_t fastkst_validate_tm(const struct tm *tm, size_t n,
+                           uint64_t *invalid, uint8_t *reason)
+{
+  uint64_t word = 0;
+  size_t i, bad = 0;
+
+  if (n > 0 && tm == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    const struct tm *tp = &tm[i];
+    uint8_t r = check_row(tp->tm_year, tp->tm_mon, tp->tm_mday,
+                          tp->tm_hour, tp->tm_min, tp->tm_sec);
+    if (reason)
+      reason[i] = r;
+    bad += r != 0;
+    BITMAP_PUT(invalid, word, i, n, r != 0);
+  }
+  return bad;
+}
+
+size_t fastkst_validate_soa(const fastkst_tm_soa_t *cols, size_t n,
+                            uint64_t *invalid, uint8_t *reason)
+{
+  uint64_t word = 0;
+  size_t i, bad = 0;
+
+  if (cols == NULL || (n > 0 && (cols->year == NULL || cols->mon == NULL ||
+                                 cols->mday == NULL || cols->hour == NULL ||
+                                 cols->min == NULL || cols->sec == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    uint8_t r = check_row(cols->year[i], cols->mon[i], cols->mday[i],
+                          cols->hour[i], cols->min[i], cols->sec[i]);
+    if (reason)
+      reason[i] = r;
+    bad += r != 0;
+    BITMAP_PUT(invalid, word, i, n, r != 0);
+  }
+  return bad;
+}
+
+size_t fastkst_normalize_tm(struct tm *tm, size_t n, uint64_t *changed)
+{
+  uint64_t word = 0;
+  size_t i, failed = 0;
+
+  if (n > 0 && tm == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    struct tm *tp = &tm[i];
+    row_t in, out;
+    int ok;
+
+    in.year = tp->tm_year;
+    in.mon = tp->tm_mon;
+    in.mday = tp->tm_mday;
+    in.hour = tp->tm_hour;
+    in.min = tp->tm_min;
+    in.sec = tp->tm_sec;
+    ok = normalize_row(&in, &out);
+
+    /* selects, not branches: rows that overflow keep their values */
+    tp->tm_year = (int)(ok ? out.year : in.year);
+    tp->tm_mon = (int)(ok ? out.mon : in.mon);
+    tp->tm_mday = (int)(ok ? out.mday : in.mday);
+    tp->tm_hour = (int)(ok ? out.hour : in.hour);
+    tp->tm_min = (int)(ok ? out.min : in.min);
+    tp->tm_sec = (int)(ok ? out.sec : in.sec);
+    tp->tm_wday = (int)(ok ? out.wday : tp->tm_wday);
+    tp->tm_yday = (int)(ok ? out.yday : tp->tm_yday);
+    tp->tm_isdst = ok ? 0 : tp->tm_isdst;
+    tp->tm_gmtoff = ok ? KST_OFFSET : tp->tm_gmtoff;
+    tp->tm_zone = ok ? "KST" : tp->tm_zone;
+
+    failed += !ok;
+    BITMAP_PUT(changed, word, i, n, ok & row_differs(&in, &out));
+  }
+  return failed;
+}
+
+size_t fastkst_normalize_soa(fastkst_tm_soa_t *cols, size_t n, uint64_t *changed)
+{
+  uint64_t word = 0;
+  size_t i, failed = 0;
+
+  if (cols == NULL || (n > 0 && (cols->year == NULL || cols->mon == NULL ||
+                                 cols->mday == NULL || cols->hour == NULL ||
+                                 cols->min == NULL || cols->sec == NULL))) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) {
+    row_t in, out;
+    int ok;
+
+    in.year = cols->year[i];
+    in.mon = cols->mon[i];
+    in.mday = cols->mday[i];
+    in.hour = cols->hour[i];
+    in.min = cols->min[i];
+    in.sec = cols->sec[i];
+    ok = normalize_row(&in, &out);
+
+    cols->year[i] = (int32_t)(ok ? out.year : in.year);
+    cols->mon[i] = (int32_t)(ok ? out.mon : in.mon);
+    cols->mday[i] = (int32_t)(ok ? out.mday : in.mday);
+    cols->hour[i] = (int32_t)(ok ? out.hour : in.hour);
+    cols->min[i] = (int32_t)(ok ? out.min : in.min);
+    cols->sec[i] = (int32_t)(ok ? out.sec : in.sec);
+    if (cols->wday)
+      cols->wday[i] = (int32_t)(ok ? out.wday : cols->wday[i]);
+    if (cols->yday)
+      cols->yday[i] = (int32_t)(ok ? out.yday : cols->yday[i]);
+
+    failed += !ok;
+    BITMAP_PUT(changed, word, i, n, ok & row_differs(&in, &out));
+  }
+  return failed;
+}
+
+/* 테스트 코드 */
+#ifdef TEST_FASTKST_VALIDATE
+/* 빌드 방법
+gcc -DTEST_FASTKST_VALIDATE -o fastkst_validate_test fastkst_validate.c fastkst_localtime.c
+./fastkst_validate_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(cond, msg)                                  \
+  do {                                                    \
+    if (cond) {                                           \
+      printf("[PASS] %s\n", msg);                         \
+    } else {                                              \
+      printf("[FAIL] %s\n", msg);                         \
+      failures++;                                         \
+    }                                                     \
+  } while (0)
+
+static double now_sec(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Straightforward reference */
+static uint8_t slow_check(const struct tm *tp)
+{
+  static const int mdays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+  uint8_t r = 0;
+  long y = tp->tm_year + 1900L;
+
+  if (tp->tm_mon < 0 || tp->tm_mon > 11) {
+    r |= FASTKST_TM_BAD_MON;
+    if (tp->tm_mday < 1 || tp->tm_mday > 31)
+      r |= FASTKST_TM_BAD_MDAY;
+  } else {
+    int len = mdays[tp->tm_mon] + (tp->tm_mon == 1 && __isleap(y));
+    if (tp->tm_mday < 1 || tp->tm_mday > len)
+      r |= FASTKST_TM_BAD_MDAY;
+  }
+  if (tp->tm_hour < 0 || tp->tm_hour > 23)
+    r |= FASTKST_TM_BAD_HOUR;
+  if (tp->tm_min < 0 || tp->tm_min > 59)
+    r |= FASTKST_TM_BAD_MIN;
+  if (tp->tm_sec < 0 || tp->tm_sec > 60)
+    r |= FASTKST_TM_BAD_SEC;
+  return r;
+}
+
+static int rnd(int lo, int hi)
+{
+  return lo + rand() % (hi - lo + 1);
+}
+
+int main(void)
+{
+  enum { N = 300000 };
+  struct tm *rows = calloc(N, sizeof(struct tm));
+  struct tm *ref = calloc(N, sizeof(struct tm));
+  uint64_t bitmap[(N + 63) / 64], changed[(N + 63) / 64];
+  uint8_t *reason = malloc(N);
+  size_t i, nbad, want_bad = 0;
+  int bad;
+  double t0, t1, t2;
+
+  printf("=== FASTKST_VALIDATE Test ===\n\n");
+
+  srand(87);
+  for (i = 0; i < N; i++) {
+    struct tm *tp = &rows[i];
+    int wild = rand() % 4 == 0;
+
+    tp->tm_year = rnd(-1000, 1000);
+    tp->tm_mon = wild ? rnd(-30, 30) : rnd(0, 11);
+    tp->tm_mday = wild ? rnd(-400, 400) : rnd(1, 31);
+    tp->tm_hour = wild ? rnd(-100, 100) : rnd(0, 24);
+    tp->tm_min = wild ? rnd(-5000, 5000) : rnd(0, 59);
+    tp->tm_sec = wild ? rnd(-100000, 100000) : rnd(0, 60);
+  }
+  rows[0].tm_year = 124; rows[0].tm_mon = 1; rows[0].tm_mday = 29;    /* 2024-02-29 */
+  rows[0].tm_hour = 12; rows[0].tm_min = 0; rows[0].tm_sec = 0;
+  rows[1] = rows[0];
+  rows[1].tm_year = 125;                                              /* 2025-02-29 */
+  rows[2] = rows[0];
+  rows[2].tm_hour = 24;
+
+  nbad = fastkst_validate_tm(rows, N, bitmap, reason);
+  bad = 0;
+  for (i = 0; i < N; i++) {
+    uint8_t r = slow_check(&rows[i]);
+    want_bad += r != 0;
+    bad += reason[i] != r || (int)((bitmap[i >> 6] >> (i & 63)) & 1) != (r != 0);
+  }
+  CHECK(bad == 0 && nbad == want_bad, "validation matches the reference");
+  CHECK(reason[0] == 0 && reason[1] == FASTKST_TM_BAD_MDAY && reason[2] == FASTKST_TM_BAD_HOUR,
+        "Feb 29 by leap year, hour 24");
+
+  /* SoA validation gives the same answer */
+  {
+    fastkst_tm_soa_t cols;
+    uint64_t bitmap2[(N + 63) / 64];
+    int32_t *col = malloc(6 * N * sizeof(int32_t));
+
+    memset(&cols, 0, sizeof(cols));
+    cols.year = col; cols.mon = col + N; cols.mday = col + 2 * N;
+    cols.hour = col + 3 * N; cols.min = col + 4 * N; cols.sec = col + 5 * N;
+    for (i = 0; i < N; i++) {
+      cols.year[i] = rows[i].tm_year; cols.mon[i] = rows[i].tm_mon;
+      cols.mday[i] = rows[i].tm_mday; cols.hour[i] = rows[i].tm_hour;
+      cols.min[i] = rows[i].tm_min; cols.sec[i] = rows[i].tm_sec;
+    }
+    CHECK(fastkst_validate_soa(&cols, N, bitmap2, NULL) == nbad &&
+          memcmp(bitmap, bitmap2, sizeof(bitmap)) == 0, "SoA validation");
+
+    fastkst_normalize_soa(&cols, N, NULL);
+    memcpy(ref, rows, N * sizeof(struct tm));
+    fastkst_normalize_tm(ref, N, NULL);
+    bad = 0;
+    for (i = 0; i < N; i++)
+      bad += cols.year[i] != ref[i].tm_year || cols.mon[i] != ref[i].tm_mon ||
+             cols.mday[i] != ref[i].tm_mday || cols.sec[i] != ref[i].tm_sec;
+    CHECK(bad == 0, "SoA normalisation");
+    free(col);
+  }
+
+  /* Normalisation against timegm(); from here reason != 0 means "expected to
+     change", which also covers valid rows with a leap second */
+  for (i = 0; i < N; i++)
+    reason[i] |= rows[i].tm_sec == 60 ? 0x80 : 0;
+  memcpy(ref, rows, N * sizeof(struct tm));
+  t0 = now_sec();
+  for (i = 0; i < N; i++)
+    timegm(&ref[i]);
+  t1 = now_sec();
+  CHECK(fastkst_normalize_tm(rows, N, changed) == 0, "normalise all rows");
+  t2 = now_sec();
+
+  bad = 0;
+  for (i = 0; i < N; i++) {
+    const struct tm *a = &rows[i], *b = &ref[i];
+    bad += a->tm_year != b->tm_year || a->tm_mon != b->tm_mon || a->tm_mday != b->tm_mday ||
+           a->tm_hour != b->tm_hour || a->tm_min != b->tm_min || a->tm_sec != b->tm_sec ||
+           a->tm_wday != b->tm_wday || a->tm_yday != b->tm_yday ||
+           (int)((changed[i >> 6] >> (i & 63)) & 1) != (reason[i] != 0);
+  }
+  CHECK(bad == 0, "normalisation matches timegm(), changed bitmap = invalid rows");
+  CHECK(fastkst_validate_tm(rows, N, NULL, NULL) == 0, "normalised rows validate");
+  printf("  %d rows: timegm %.1f ms, normalise %.1f ms\n", N, (t1 - t0) * 1e3, (t2 - t1) * 1e3);
+
+  /* Year overflow leaves the row alone */
+  {
+    struct tm big;
+    uint64_t ch = 1;
+
+    memset(&big, 0, sizeof(big));
+    big.tm_year = INT_MAX;
+    big.tm_mon = 12;
+    big.tm_mday = 1;
+    CHECK(fastkst_normalize_tm(&big, 1, &ch) == 1 && big.tm_mon == 12 && ch == 0,
+          "year overflow reported, row kept");
+  }
+
+  free(rows);
+  free(ref);
+  free(reason);
+
+  printf("\n");
+  if (failures == 0) {
+    printf("[PASS] All validate tests passed!\n");
+    return 0;
+  }
+  printf("[FAIL] %d validate test(s) failed!\n", failures);
+  return 1;
+}
+#endif
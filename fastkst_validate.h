@@ -0,0 +1,98 @@
+/**
+ * @file fastkst_validate.h
+ * @brief Bulk validation and normalisation of broken-down KST times
+ * @author lmk (newtypez@gmail.com)
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Works on struct tm arrays or on structure-of-arrays columns, using the
+ *    struct tm field conventions (tm_year = year - 1900, tm_mon = 0..11).
+ *  - Every row goes through the same straight-line code: range checks are
+ *    combined with bitwise operators, month lengths come from __mon_yday
+ *    with a clamped index, and carries use floor division, so there is no
+ *    data-dependent branch per row.
+ *  - tm_sec = 60 (leap second) is valid, as in struct tm; normalisation
+ *    carries it into the next minute like mktime() does.
+ */
+
+#ifndef FASTKST_VALIDATE_H
+#define FASTKST_VALIDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-row reason bits */
+#define FASTKST_TM_BAD_MON    0x01    /**< tm_mon outside 0..11 */
+#define FASTKST_TM_BAD_MDAY   0x02    /**< tm_mday outside 1..month length */
+#define FASTKST_TM_BAD_HOUR   0x04    /**< tm_hour outside 0..23 */
+#define FASTKST_TM_BAD_MIN    0x08    /**< tm_min outside 0..59 */
+#define FASTKST_TM_BAD_SEC    0x10    /**< tm_sec outside 0..60 */
+
+/**
+ * @brief Broken-down times as columns (tm_* conventions)
+ *
+ * wday and yday are outputs of normalisation only and may be NULL.
+ */
+typedef struct {
+  int32_t *year;              /**< years since 1900 */
+  int32_t *mon;               /**< 0..11 */
+  int32_t *mday;              /**< 1..31 */
+  int32_t *hour;
+  int32_t *min;
+  int32_t *sec;
+  int32_t *wday;              /**< out: 0..6, Sunday = 0 (optional) */
+  int32_t *yday;              /**< out: 0..365 (optional) */
+} fastkst_tm_soa_t;
+
+/**
+ * @brief Check struct tm rows
+ * @param[in] tm rows
+ * @param[in] n number of rows
+ * @param[out] invalid bitmap, (n + 63) / 64 words; bit i is set when row i
+ *             is invalid (optional, can be NULL)
+ * @param[out] reason FASTKST_TM_BAD_* bits per row (optional, can be NULL)
+ * @return size_t number of invalid rows
+ *
+ * @note tm_wday, tm_yday and the zone fields are not checked.
+ */
+size_t fastkst_validate_tm(const struct tm *tm, size_t n,
+                           uint64_t *invalid, uint8_t *reason);
+
+/**
+ * @brief Column version of fastkst_validate_tm()
+ */
+size_t fastkst_validate_soa(const fastkst_tm_soa_t *cols, size_t n,
+                            uint64_t *invalid, uint8_t *reason);
+
+/**
+ * @brief Normalise struct tm rows in place, mktime()-style
+ * @param[in,out] tm rows; out-of-range fields are carried upwards
+ *                (sec -> min -> hour -> day -> month -> year, negative
+ *                values borrow) and tm_wday / tm_yday are recomputed.
+ *                tm_isdst, tm_gmtoff and tm_zone are set to the KST values.
+ * @param[in] n number of rows
+ * @param[out] changed bitmap of rows whose date/time fields changed
+ *             (optional, can be NULL)
+ * @return size_t number of rows left unchanged because the resulting year
+ *         does not fit in tm_year (their bit in changed is clear)
+ */
+size_t fastkst_normalize_tm(struct tm *tm, size_t n, uint64_t *changed);
+
+/**
+ * @brief Column version of fastkst_normalize_tm()
+ */
+size_t fastkst_normalize_soa(fastkst_tm_soa_t *cols, size_t n, uint64_t *changed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FASTKST_VALIDATE_H */
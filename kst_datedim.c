@@ -0,0 +1,84 @@
+/**
+ * @file kst_datedim.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Write a date dimension table (one row per KST day) as CSV
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Usage:
+ *      kst_datedim 1900-01-01 2099-12-31 > dim_date.csv
+ *      kst_datedim -H -o dim_date.csv 2025-01-01 2025-12-31
+ *  - Both ends are inclusive. Columns are listed in fastkst_datedim.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "fastkst_datedim.h"
+
+static int parse_date(const char *s, int64_t *day)
+{
+  int y, m, d;
+  char end;
+
+  if (sscanf(s, "%d-%d-%d%c", &y, &m, &d, &end) != 3 ||
+      y < 1 || y > 9999 || m < 1 || m > 12 || d < 1 || d > 31)
+    return 0;
+  *day = fastkst_datedim_epoch_day(y, m, d);
+  /* reject 2025-02-30 and the like */
+  return *day < (m == 12 ? fastkst_datedim_epoch_day(y + 1, 1, 1)
+                         : fastkst_datedim_epoch_day(y, m + 1, 1));
+}
+
+static void usage(const char *prog)
+{
+  fprintf(stderr,
+          "Usage: %s [-H] [-o file] START END\n"
+          "  START, END  first and last day, YYYY-MM-DD (0001-01-01 .. 9999-12-31)\n"
+          "  -H          do not write the header line\n"
+          "  -o          output file (default: stdout)\n",
+          prog);
+}
+
+int main(int argc, char **argv)
+{
+  const char *out_path = NULL;
+  int64_t first, last;
+  int header = 1;
+  FILE *fp = stdout;
+  int opt, ok;
+
+  while ((opt = getopt(argc, argv, "Ho:h")) != -1) {
+    switch (opt) {
+    case 'H': header = 0; break;
+    case 'o': out_path = optarg; break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind != 2 || !parse_date(argv[optind], &first) ||
+      !parse_date(argv[optind + 1], &last) || last < first) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  if (out_path != NULL && (fp = fopen(out_path, "w")) == NULL) {
+    fprintf(stderr, "%s: %s: %s\n", argv[0], out_path, strerror(errno));
+    return 1;
+  }
+
+  ok = fastkst_datedim_write_csv(fp, first, (size_t)(last - first + 1), header);
+  if (fflush(fp) != 0)
+    ok = 0;
+  if (!ok)
+    fprintf(stderr, "%s: %s: %s\n", argv[0], out_path ? out_path : "stdout", strerror(errno));
+  if (out_path != NULL && fclose(fp) != 0)
+    ok = 0;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,415 @@
+/**
+ * @file kst_logmerge.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Merge per-host log files into one timeline ordered by KST timestamp
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Usage:
+ *      kst_logmerge web*.log db*.log > timeline.log
+ *      kst_logmerge -r -o timeline.log host1/syslog host2/app.log
+ *  - Each input is mmap()ed and every line's leading timestamp is parsed
+ *    to epoch seconds with the fastkst_parse.h parsers (ISO 8601, RFC 3164
+ *    syslog, RFC 2822 / HTTP-date, CLF at the first '['). With -f auto the
+ *    layout is detected per line, trying the one that matched last first,
+ *    so inputs may mix layouts.
+ *  - Lines without a timestamp (stack traces, continuation lines) keep the
+ *    key of the line before them and stay attached to it.
+ *  - Inputs are merged with a loser tree: one comparison per tree level
+ *    per output line. Equal keys keep the input order (stable), so each
+ *    input is expected to be sorted already, like sort -m.
+ *  - -r replaces each timestamp with "YYYY-MM-DD HH:MM:SS" KST (an ISO 8601
+ *    fraction is kept) through fastkst_fmtstream, which suits the sorted
+ *    output.
+ *  - A syslog line has no year: it gets the latest year that puts it at or
+ *    before the input's mtime (plus SYSLOG_SLACK for clock skew).
+ *  - Output goes through a 1 MiB buffer and write(2).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "fastkst_parse.h"
+#include "fastkst_fmtstream.h"
+
+#define OUT_BUFSIZE  (1 << 20)
+#define FMT_AUTO     (-1)
+#define NFORMATS     5
+#define SYSLOG_SLACK 3600
+
+typedef struct {
+  const char *name;
+  const char *base;         /* mmap()ed file */
+  size_t size;
+  size_t pos;               /* start of the next line */
+  time_t ref;               /* syslog upper bound: file mtime */
+  int last_fmt;             /* layout that matched last, FMT_AUTO if none */
+  int done;
+
+  /* current line */
+  const char *line;
+  size_t len;
+  time_t key;
+  long nsec;                /* ISO 8601 fraction, for ordering within a second */
+  size_t ts_off;            /* timestamp span, ts_len 0 if the line has none */
+  size_t ts_len;
+  size_t frac_len;          /* ISO 8601 fraction kept by -r, after the seconds */
+} input_t;
+
+static int fixed_fmt = FMT_AUTO;
+static int rerender = 0;
+
+/* Auto detection order: cheap leading layouts first, CLF searches for '[' */
+static const int detect_order[NFORMATS] = {
+  FASTKST_FMT_ISO8601, FASTKST_FMT_SYSLOG, FASTKST_FMT_RFC2822,
+  FASTKST_FMT_HTTP, FASTKST_FMT_CLF
+};
+
+/* Parse one layout at the start of the line (CLF: at the first '[') */
+static int try_format(input_t *in, int fmt, const char *s, size_t len)
+{
+  size_t off = 0, r = 0;
+  time_t t;
+
+  switch (fmt) {
+  case FASTKST_FMT_CLF: {
+    const char *b = memchr(s, '[', len);
+    if (b == NULL)
+      return 0;
+    off = (size_t)(b - s);
+    r = fastkst_parse_clf(b, len - off, &t);
+    if (r == 28) {              /* replace inside the brackets */
+      off++;
+      r -= 2;
+    }
+    break;
+  }
+  case FASTKST_FMT_SYSLOG:
+    if (len > 0 && s[0] == '<') {
+      const char *e = memchr(s, '>', len < 6 ? len : 6);
+      if (e == NULL)
+        return 0;
+      off = (size_t)(e + 1 - s);
+    }
+    r = fastkst_parse_syslog_before(s + off, len - off, in->ref, SYSLOG_SLACK, &t);
+    break;
+  case FASTKST_FMT_HTTP:
+    r = fastkst_parse_http_date(s, len, &t);
+    break;
+  case FASTKST_FMT_RFC2822:
+    r = fastkst_parse_rfc2822(s, len, &t);
+    break;
+  case FASTKST_FMT_ISO8601:
+    r = fastkst_parse_iso8601(s, len, &t);
+    break;
+  }
+  if (r == 0)
+    return 0;
+
+  in->key = t;
+  in->nsec = 0;
+  in->ts_off = off;
+  in->ts_len = r;
+  in->frac_len = 0;
+  if (fmt == FASTKST_FMT_ISO8601 && r > 20 && (s[19] == '.' || s[19] == ',')) {
+    size_t i;
+    int d = 0;
+
+    for (i = 20; i < r && s[i] >= '0' && s[i] <= '9'; i++) {
+      if (d < 9) {
+        in->nsec = in->nsec * 10 + (s[i] - '0');
+        d++;
+      }
+    }
+    while (d++ < 9)
+      in->nsec *= 10;
+    in->frac_len = i - 19;
+  }
+  in->last_fmt = fmt;
+  return 1;
+}
+
+static void parse_line(input_t *in)
+{
+  int i;
+
+  in->ts_len = 0;
+  if (fixed_fmt != FMT_AUTO) {
+    try_format(in, fixed_fmt, in->line, in->len);
+    return;
+  }
+  if (in->last_fmt != FMT_AUTO && try_format(in, in->last_fmt, in->line, in->len))
+    return;
+  for (i = 0; i < NFORMATS; i++) {
+    if (detect_order[i] != in->last_fmt &&
+        try_format(in, detect_order[i], in->line, in->len))
+      return;
+  }
+  /* no timestamp: key and nsec of the previous line are kept */
+}
+
+static void advance(input_t *in)
+{
+  const char *nl;
+
+  if (in->pos >= in->size) {
+    in->done = 1;
+    return;
+  }
+  in->line = in->base + in->pos;
+  nl = memchr(in->line, '\n', in->size - in->pos);
+  in->len = nl ? (size_t)(nl - in->line) + 1 : in->size - in->pos;
+  in->pos += in->len;
+  parse_line(in);
+}
+
+static int open_input(input_t *in, const char *path)
+{
+  struct stat st;
+  int fd;
+
+  memset(in, 0, sizeof(*in));
+  in->name = path;
+  in->last_fmt = FMT_AUTO;
+  in->key = INT64_MIN;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return 0;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return 0;
+  }
+  in->ref = st.st_mtime;
+  in->size = (size_t)st.st_size;
+  if (in->size > 0) {
+    void *p = mmap(NULL, in->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      return 0;
+    }
+    madvise(p, in->size, MADV_SEQUENTIAL);
+    in->base = p;
+  }
+  close(fd);
+  advance(in);
+  return 1;
+}
+
+/* ---- loser tree ---- */
+
+static input_t *inputs;
+static int *loser;          /* loser[0] = winner, loser[1..k-1] = internal nodes */
+static int ninputs;
+
+/* Input a goes out before input b */
+static inline int before(int a, int b)
+{
+  const input_t *x = &inputs[a], *y = &inputs[b];
+
+  if (x->done != y->done)
+    return y->done;
+  if (x->done)
+    return a < b;
+  if (x->key != y->key)
+    return x->key < y->key;
+  if (x->nsec != y->nsec)
+    return x->nsec < y->nsec;
+  return a < b;
+}
+
+static void tree_build(void)
+{
+  int *win = malloc(sizeof(int) * 2 * (size_t)ninputs);
+  int n;
+
+  for (n = 0; n < ninputs; n++)
+    win[ninputs + n] = n;
+  for (n = ninputs - 1; n >= 1; n--) {
+    int a = win[2 * n], b = win[2 * n + 1];
+    win[n] = before(a, b) ? a : b;
+    loser[n] = before(a, b) ? b : a;
+  }
+  loser[0] = ninputs > 1 ? win[1] : 0;
+  free(win);
+}
+
+/* Replay the path of leaf w after its input advanced */
+static void tree_replay(int w)
+{
+  int n;
+
+  for (n = (w + ninputs) / 2; n >= 1; n /= 2) {
+    if (before(loser[n], w)) {
+      int t = loser[n];
+      loser[n] = w;
+      w = t;
+    }
+  }
+  loser[0] = w;
+}
+
+/* ---- buffered output ---- */
+
+static char *obuf;
+static size_t olen;
+static int ofd = STDOUT_FILENO;
+static int write_failed = 0;
+
+static void write_all(const char *p, size_t n)
+{
+  while (n > 0 && !write_failed) {
+    ssize_t w = write(ofd, p, n);
+    if (w < 0) {
+      if (errno == EINTR)
+        continue;
+      write_failed = errno;
+      return;
+    }
+    p += w;
+    n -= (size_t)w;
+  }
+}
+
+static void out_flush(void)
+{
+  write_all(obuf, olen);
+  olen = 0;
+}
+
+static inline void out_put(const char *p, size_t n)
+{
+  if (olen + n > OUT_BUFSIZE) {
+    out_flush();
+    if (n >= OUT_BUFSIZE) {
+      write_all(p, n);
+      return;
+    }
+  }
+  memcpy(obuf + olen, p, n);
+  olen += n;
+}
+
+static void emit(input_t *in, fastkst_fmtstream_t *st)
+{
+  const char *text;
+
+  if (rerender && in->ts_len > 0 && (text = fastkst_fmtstream_next(st, in->key)) != NULL) {
+    out_put(in->line, in->ts_off);
+    out_put(text, 19);
+    out_put(in->line + in->ts_off + 19, in->frac_len);
+    out_put(in->line + in->ts_off + in->ts_len, in->len - in->ts_off - in->ts_len);
+  } else {
+    out_put(in->line, in->len);
+  }
+  if (in->line[in->len - 1] != '\n')
+    out_put("\n", 1);
+}
+
+static void usage(const char *prog)
+{
+  fprintf(stderr,
+          "Usage: %s [-f layout] [-r] [-o file] FILE...\n"
+          "  -f  timestamp layout: auto (default), iso, syslog, rfc2822, http, clf\n"
+          "  -r  rewrite every timestamp as YYYY-MM-DD HH:MM:SS (KST)\n"
+          "  -o  output file (default: stdout)\n",
+          prog);
+}
+
+static int parse_layout(const char *s)
+{
+  static const char *const names[] = { "clf", "syslog", "http", "rfc2822", "iso" };
+  int i;
+
+  if (strcmp(s, "auto") == 0)
+    return FMT_AUTO;
+  for (i = 0; i < NFORMATS; i++)
+    if (strcmp(s, names[i]) == 0)
+      return i;
+  return -2;
+}
+
+int main(int argc, char **argv)
+{
+  const char *out_path = NULL;
+  fastkst_fmtstream_t st;
+  int opt, i, ret = 0;
+
+  while ((opt = getopt(argc, argv, "f:ro:h")) != -1) {
+    switch (opt) {
+    case 'f':
+      if ((fixed_fmt = parse_layout(optarg)) == -2) {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+    case 'r': rerender = 1; break;
+    case 'o': out_path = optarg; break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (optind == argc) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  inputs = calloc((size_t)(argc - optind), sizeof(*inputs));
+  loser = calloc((size_t)(argc - optind), sizeof(*loser));
+  obuf = malloc(OUT_BUFSIZE);
+  if (inputs == NULL || loser == NULL || obuf == NULL) {
+    fprintf(stderr, "%s: %s\n", argv[0], strerror(errno));
+    return 1;
+  }
+  for (i = optind; i < argc; i++) {
+    if (!open_input(&inputs[ninputs], argv[i])) {
+      fprintf(stderr, "%s: %s: %s\n", argv[0], argv[i], strerror(errno));
+      ret = 1;
+      continue;
+    }
+    ninputs++;
+  }
+  if (ninputs == 0)
+    return 1;
+
+  if (out_path != NULL && (ofd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0) {
+    fprintf(stderr, "%s: %s: %s\n", argv[0], out_path, strerror(errno));
+    return 1;
+  }
+
+  fastkst_fmtstream_init(&st);
+  tree_build();
+  while (!inputs[loser[0]].done && !write_failed) {
+    int w = loser[0];
+
+    emit(&inputs[w], &st);
+    advance(&inputs[w]);
+    tree_replay(w);
+  }
+  out_flush();
+
+  if (write_failed) {
+    fprintf(stderr, "%s: %s: %s\n", argv[0], out_path ? out_path : "stdout",
+            strerror(write_failed));
+    ret = 1;
+  }
+  if (out_path != NULL && close(ofd) != 0)
+    ret = 1;
+  for (i = 0; i < ninputs; i++)
+    if (inputs[i].size > 0)
+      munmap((void *)inputs[i].base, inputs[i].size);
+  free(inputs);
+  free(loser);
+  free(obuf);
+  return ret;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file kst_trace.c
+ * @author lmk (newtypez@gmail.com)
+ * @brief Rewrite boot-relative timestamps in dmesg / perf / trace output as KST
+ * @version 0.1
+ * @date 2025-12-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @note
+ *  - Usage:
+ *      kst_trace -S snap.txt                 capture and save a clock snapshot
+ *      dmesg | kst_trace                     convert using the live clocks
+ *      kst_trace -s snap.txt -c boot f.txt   convert offline with a saved snapshot
+ *  - The first "seconds.fraction" number of each line is converted
+ *    (dmesg "[   12.345678]", perf script "  1234.567890:"). With -n the
+ *    first integer is taken as raw nanoseconds (eBPF tracer output).
+ *  - Lines are converted in batches of LINE_BATCH through
+ *    fastkst_clock_format_batch().
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "fastkst_boottime.h"
+
+#define LINE_BATCH  4096
+#define OUT_STRIDE  32
+
+typedef struct {
+  char *line;
+  size_t len;
+  size_t ts_off;     /* start of the replaced span */
+  size_t ts_len;     /* length of the replaced span, 0 if none */
+} trace_line_t;
+
+static int raw_ns = 0;
+
+/* Find the timestamp span of a line and parse it to nanoseconds */
+static int find_timestamp(const char *s, size_t len, size_t *off, size_t *span,
+                          int64_t *ns)
+{
+  size_t i = 0, start, j;
+  int64_t sec = 0, frac = 0;
+  int digits = 0, big;
+
+  for (;;) {
+    while (i < len && (s[i] < '0' || s[i] > '9'))
+      i++;
+    if (i >= len)
+      return 0;
+
+    /* numbers that do not fit are not timestamps: keep looking */
+    start = i;
+    sec = 0;
+    big = 0;
+    for (; i < len && s[i] >= '0' && s[i] <= '9'; i++) {
+      if (sec > (INT64_MAX - 9) / 10)
+        big = 1;
+      else
+        sec = sec * 10 + (s[i] - '0');
+    }
+
+    if (raw_ns) {
+      if (big)
+        continue;
+      *ns = sec;
+      break;
+    }
+    if (i + 1 < len && s[i] == '.' && s[i + 1] >= '0' && s[i + 1] <= '9') {
+      i++;
+      frac = 0;
+      digits = 0;
+      while (i < len && s[i] >= '0' && s[i] <= '9') {
+        if (digits < 9) {
+          frac = frac * 10 + (s[i] - '0');
+          digits++;
+        }
+        i++;
+      }
+      while (digits++ < 9)
+        frac *= 10;
+      if (big || sec > (INT64_MAX - 999999999LL) / 1000000000LL)
+        continue;
+      *ns = sec * 1000000000LL + frac;
+      break;
+    }
+  }
+
+  /* dmesg pads inside the brackets: swallow the padding as well */
+  for (j = start; j > 0 && s[j - 1] == ' '; j--)
+    continue;
+  if (j > 0 && s[j - 1] == '[')
+    start = j;
+
+  *off = start;
+  *span = i - start;
+  return 1;
+}
+
+static void flush_batch(const fastkst_clock_snapshot_t *snap, fastkst_clock_src_t src,
+                        int precision, trace_line_t *lines, size_t nlines,
+                        int64_t *ns, size_t n, char *fmt)
+{
+  size_t i, k = 0;
+
+  if (fastkst_clock_format_batch(snap, src, ns, n, fmt, OUT_STRIDE, precision) != n) {
+    /* out of range rows keep their original text */
+    for (i = 0; i < n; i++)
+      fmt[i * OUT_STRIDE] = '\0';
+    for (i = 0; i < n; i++)
+      fastkst_clock_format_batch(snap, src, &ns[i], 1, fmt + i * OUT_STRIDE,
+                                 OUT_STRIDE, precision);
+  }
+
+  for (i = 0; i < nlines; i++) {
+    trace_line_t *l = &lines[i];
+    const char *f;
+
+    if (l->ts_len == 0) {
+      fwrite(l->line, 1, l->len, stdout);
+      continue;
+    }
+    f = fmt + (k++) * OUT_STRIDE;
+    if (*f == '\0') {
+      fwrite(l->line, 1, l->len, stdout);
+      continue;
+    }
+    fwrite(l->line, 1, l->ts_off, stdout);
+    fputs(f, stdout);
+    fwrite(l->line + l->ts_off + l->ts_len, 1, l->len - l->ts_off - l->ts_len, stdout);
+  }
+}
+
+static int convert_stream(FILE *in, const fastkst_clock_snapshot_t *snap,
+                          fastkst_clock_src_t src, int precision)
+{
+  static trace_line_t lines[LINE_BATCH * 2];
+  static int64_t ns[LINE_BATCH];
+  static char fmt[LINE_BATCH * OUT_STRIDE];
+  size_t nlines = 0, nts = 0, i;
+  char *line = NULL;
+  size_t cap = 0;
+  ssize_t len;
+
+  while ((len = getline(&line, &cap, in)) >= 0) {
+    trace_line_t *l = &lines[nlines++];
+
+    l->line = line;
+    l->len = (size_t)len;
+    l->ts_len = 0;
+    if (find_timestamp(line, (size_t)len, &l->ts_off, &l->ts_len, &ns[nts]))
+      nts++;
+    line = NULL;
+    cap = 0;
+
+    if (nts == LINE_BATCH || nlines == LINE_BATCH * 2) {
+      flush_batch(snap, src, precision, lines, nlines, ns, nts, fmt);
+      for (i = 0; i < nlines; i++)
+        free(lines[i].line);
+      nlines = nts = 0;
+    }
+  }
+  free(line);
+
+  flush_batch(snap, src, precision, lines, nlines, ns, nts, fmt);
+  for (i = 0; i < nlines; i++)
+    free(lines[i].line);
+  return ferror(in) ? 0 : 1;
+}
+
+static void usage(const char *prog)
+{
+  fprintf(stderr,
+          "Usage: %s [-c mono|boot] [-s snapshot] [-p digits] [-n] [file...]\n"
+          "       %s -S snapshot\n"
+          "  -c  source clock of the timestamps (default: mono)\n"
+          "  -s  use a saved clock snapshot instead of the live clocks\n"
+          "  -S  capture the live clock offsets into a snapshot file and exit\n"
+          "  -p  fraction digits, 0..9 (default: 6)\n"
+          "  -n  timestamps are raw integer nanoseconds\n",
+          prog, prog);
+}
+
+int main(int argc, char **argv)
+{
+  fastkst_clock_snapshot_t snap;
+  fastkst_clock_src_t src = FASTKST_CLOCK_MONOTONIC;
+  const char *load_path = NULL, *save_path = NULL;
+  int precision = 6;
+  int opt, i, ret = 0;
+
+  while ((opt = getopt(argc, argv, "c:s:S:p:nh")) != -1) {
+    switch (opt) {
+    case 'c':
+      if (strcmp(optarg, "mono") == 0)
+        src = FASTKST_CLOCK_MONOTONIC;
+      else if (strcmp(optarg, "boot") == 0)
+        src = FASTKST_CLOCK_BOOTTIME;
+      else {
+        usage(argv[0]);
+        return 2;
+      }
+      break;
+    case 's': load_path = optarg; break;
+    case 'S': save_path = optarg; break;
+    case 'p': precision = atoi(optarg); break;
+    case 'n': raw_ns = 1; break;
+    default:
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (precision < 0 || precision > 9) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  if (load_path != NULL) {
+    if (!fastkst_clock_snapshot_load(&snap, load_path)) {
+      fprintf(stderr, "%s: %s: %s\n", argv[0], load_path, strerror(errno));
+      return 1;
+    }
+  } else if (!fastkst_clock_snapshot_capture(&snap)) {
+    fprintf(stderr, "%s: clock snapshot failed: %s\n", argv[0], strerror(errno));
+    return 1;
+  }
+
+  if (save_path != NULL) {
+    if (!fastkst_clock_snapshot_save(&snap, save_path)) {
+      fprintf(stderr, "%s: %s: %s\n", argv[0], save_path, strerror(errno));
+      return 1;
+    }
+    return 0;
+  }
+
+  if (optind == argc)
+    return convert_stream(stdin, &snap, src, precision) ? 0 : 1;
+
+  for (i = optind; i < argc; i++) {
+    FILE *fp = fopen(argv[i], "r");
+
+    if (fp == NULL) {
+      fprintf(stderr, "%s: %s: %s\n", argv[0], argv[i], strerror(errno));
+      ret = 1;
+      continue;
+    }
+    if (!convert_stream(fp, &snap, src, precision))
+      ret = 1;
+    fclose(fp);
+  }
+  return ret;
+}